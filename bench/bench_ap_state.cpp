@@ -0,0 +1,55 @@
+#include "bench_ap_state.h"
+
+BenchSlot& GetBenchSlot() {
+  static BenchSlot* instance = new BenchSlot();
+  return *instance;
+}
+
+bool AP_HasItem(int item_id, int quantity) {
+  const std::map<int64_t, int>& inventory = GetBenchSlot().inventory;
+  return inventory.count(item_id) && inventory.at(item_id) >= quantity;
+}
+
+void AP_VisitInventory(
+    const std::function<void(int64_t ap_item_id, int count)>& visitor) {
+  for (const auto& [ap_item_id, count] : GetBenchSlot().inventory) {
+    visitor(ap_item_id, count);
+  }
+}
+
+bool AP_IsLocationVisible(int classification) {
+  switch (GetBenchSlot().location_checks) {
+    case kNORMAL_LOCATIONS:
+      return classification & kLOCATION_NORMAL;
+    case kREDUCED_LOCATIONS:
+      return classification & kLOCATION_REDUCED;
+    case kPANELSANITY:
+      return classification & kLOCATION_INSANITY;
+    default:
+      return false;
+  }
+}
+
+bool AP_HasCheckedGameLocation(int location_id) { return false; }
+
+DoorShuffleMode AP_GetDoorShuffleMode() {
+  return GetBenchSlot().door_shuffle_mode;
+}
+
+bool AP_IsColorShuffle() { return GetBenchSlot().color_shuffle; }
+
+bool AP_IsPaintingShuffle() { return GetBenchSlot().painting_shuffle; }
+
+std::vector<std::vector<Exit>> AP_GetPaintingExits() {
+  return GetBenchSlot().painting_exits;
+}
+
+int AP_GetMasteryRequirement() { return GetBenchSlot().mastery_requirement; }
+
+int AP_GetLevel2Requirement() { return GetBenchSlot().level_2_requirement; }
+
+VictoryCondition AP_GetVictoryCondition() {
+  return GetBenchSlot().victory_condition;
+}
+
+bool AP_HasEarlyColorHallways() { return GetBenchSlot().early_color_hallways; }
@@ -0,0 +1,29 @@
+#ifndef BENCH_AP_STATE_H_1F7C2A94
+#define BENCH_AP_STATE_H_1F7C2A94
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "ap_state.h"
+
+// Stands in for the Archipelago connection in the benchmark, which links
+// against this instead of ap_state.cpp. The AP_* functions that the solver
+// uses read from here.
+struct BenchSlot {
+  DoorShuffleMode door_shuffle_mode = kNO_DOORS;
+  bool color_shuffle = false;
+  bool painting_shuffle = false;
+  int mastery_requirement = 21;
+  int level_2_requirement = 223;
+  VictoryCondition victory_condition = kTHE_END;
+  bool early_color_hallways = false;
+  LocationChecks location_checks = kNORMAL_LOCATIONS;
+
+  std::vector<std::vector<Exit>> painting_exits;
+  std::map<int64_t, int> inventory;
+};
+
+BenchSlot& GetBenchSlot();
+
+#endif /* end of include guard: BENCH_AP_STATE_H_1F7C2A94 */
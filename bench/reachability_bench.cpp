@@ -0,0 +1,411 @@
+// Measures the cost of reachability recalculation outside of the GUI. Run it
+// from the repository root, so that the game data can be loaded from assets/.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <new>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include "bench_ap_state.h"
+#include "game_data.h"
+#include "tracker_state.h"
+
+#ifdef _MSC_VER
+#include <malloc.h>
+#define BENCH_NOINLINE __declspec(noinline)
+#else
+#define BENCH_NOINLINE __attribute__((noinline))
+#endif
+
+namespace {
+
+std::atomic<size_t> allocation_count = 0;
+
+struct Sample {
+  double microseconds;
+  size_t allocations;
+};
+
+struct BenchConfig {
+  std::string name;
+  DoorShuffleMode door_shuffle_mode;
+  bool color_shuffle;
+  bool painting_shuffle;
+  VictoryCondition victory_condition;
+  LocationChecks location_checks;
+};
+
+// Every item that the solver looks at, with progressive items repeated once
+// per stage.
+std::vector<int> GetAllItems() {
+  std::vector<int> items;
+  std::vector<int> seen_groups;
+  std::map<int, int> progressive_stages;
+
+  for (const Door& door_obj : GD_GetDoors()) {
+    if (door_obj.ap_item_id != -1) {
+      items.push_back(door_obj.ap_item_id);
+    }
+
+    if (door_obj.group_ap_item_id != -1 &&
+        std::find(seen_groups.begin(), seen_groups.end(),
+                  door_obj.group_ap_item_id) == seen_groups.end()) {
+      seen_groups.push_back(door_obj.group_ap_item_id);
+      items.push_back(door_obj.group_ap_item_id);
+    }
+
+    for (const ProgressiveRequirement& prog_req : door_obj.progressives) {
+      int& stages = progressive_stages[prog_req.ap_item_id];
+      stages = std::max(stages, prog_req.quantity);
+    }
+  }
+
+  for (const auto& [item_id, stages] : progressive_stages) {
+    for (int i = 0; i < stages; i++) {
+      items.push_back(item_id);
+    }
+  }
+
+  for (LingoColor color :
+       {LingoColor::kBlack, LingoColor::kRed, LingoColor::kBlue,
+        LingoColor::kYellow, LingoColor::kGreen, LingoColor::kOrange,
+        LingoColor::kPurple, LingoColor::kBrown, LingoColor::kGray}) {
+    int ap_item_id = GD_FindItemIdForColor(color);
+    if (ap_item_id != -1) {
+      items.push_back(ap_item_id);
+    }
+  }
+
+  return items;
+}
+
+// A deterministic stand-in for the painting_entrance_to_exit slot data.
+std::vector<std::vector<Exit>> ShufflePaintings(std::mt19937& rng) {
+  std::vector<std::tuple<int, std::string_view, std::optional<int>>> entrances;
+  std::vector<std::string_view> exits;
+
+  int room_count = GD_GetRooms().size();
+  for (int room_id = 0; room_id < room_count; room_id++) {
+    for (const PaintingExit& painting : GD_GetRoom(room_id).paintings) {
+      entrances.push_back({room_id, painting.id, painting.door});
+      exits.push_back(painting.id);
+    }
+  }
+
+  std::shuffle(exits.begin(), exits.end(), rng);
+
+  std::vector<std::vector<Exit>> painting_exits(GD_GetRooms().size());
+  for (size_t i = 0; i < entrances.size(); i++) {
+    const auto& [room_id, painting_id, door] = entrances.at(i);
+    painting_exits[room_id].push_back(
+        {.destination_room = GD_GetRoomForPainting(exits.at(i)),
+         .door = door,
+         .painting = true});
+  }
+
+  return painting_exits;
+}
+
+template <typename F>
+Sample Measure(F&& callback) {
+  size_t allocations_before = allocation_count.load();
+  auto start = std::chrono::steady_clock::now();
+
+  callback();
+
+  auto finish = std::chrono::steady_clock::now();
+  return {.microseconds =
+              std::chrono::duration<double, std::micro>(finish - start).count(),
+          .allocations = allocation_count.load() - allocations_before};
+}
+
+void Report(const std::string& label, std::vector<Sample> samples) {
+  if (samples.empty()) {
+    return;
+  }
+
+  std::sort(samples.begin(), samples.end(),
+            [](const Sample& lhs, const Sample& rhs) {
+              return lhs.microseconds < rhs.microseconds;
+            });
+
+  auto percentile = [&samples](double fraction) {
+    return samples.at(static_cast<size_t>(fraction * (samples.size() - 1)))
+        .microseconds;
+  };
+
+  size_t total_allocations = 0;
+  for (const Sample& sample : samples) {
+    total_allocations += sample.allocations;
+  }
+
+  std::cout << std::left << std::setw(68) << label << std::right << std::fixed
+            << std::setprecision(1) << std::setw(10) << percentile(0.5)
+            << std::setw(10) << percentile(0.9) << std::setw(10)
+            << percentile(0.99) << std::setw(10) << samples.back().microseconds
+            << std::setw(12)
+            << static_cast<double>(total_allocations) / samples.size()
+            << std::endl;
+}
+
+// Every allocation goes through these, so that they can be counted. They are
+// kept out of line, as g++ otherwise warns about free() being called on memory
+// that came from operator new once they are inlined into each other.
+BENCH_NOINLINE void* Allocate(std::size_t size, std::size_t alignment) {
+  allocation_count++;
+
+  size = std::max<std::size_t>(size, 1);
+#ifdef _MSC_VER
+  return _aligned_malloc(size, alignment);
+#else
+  if (alignment <= alignof(std::max_align_t)) {
+    return std::malloc(size);
+  }
+
+  // aligned_alloc needs the size to be a multiple of the alignment.
+  return std::aligned_alloc(alignment,
+                            (size + alignment - 1) / alignment * alignment);
+#endif
+}
+
+BENCH_NOINLINE void Deallocate(void* ptr) noexcept {
+#ifdef _MSC_VER
+  _aligned_free(ptr);
+#else
+  std::free(ptr);
+#endif
+}
+
+void* AllocateOrThrow(std::size_t size, std::size_t alignment) {
+  if (void* ptr = Allocate(size, alignment)) {
+    return ptr;
+  }
+
+  throw std::bad_alloc();
+}
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+  return AllocateOrThrow(size, alignof(std::max_align_t));
+}
+
+void* operator new[](std::size_t size) {
+  return AllocateOrThrow(size, alignof(std::max_align_t));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  return AllocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+  return AllocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  return Allocate(size, alignof(std::max_align_t));
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+  return Allocate(size, alignof(std::max_align_t));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment,
+                   const std::nothrow_t&) noexcept {
+  return Allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment,
+                     const std::nothrow_t&) noexcept {
+  return Allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* ptr) noexcept { Deallocate(ptr); }
+
+void operator delete[](void* ptr) noexcept { Deallocate(ptr); }
+
+void operator delete(void* ptr, std::size_t) noexcept { Deallocate(ptr); }
+
+void operator delete[](void* ptr, std::size_t) noexcept { Deallocate(ptr); }
+
+void operator delete(void* ptr, std::align_val_t) noexcept { Deallocate(ptr); }
+
+void operator delete[](void* ptr, std::align_val_t) noexcept {
+  Deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+  Deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept {
+  Deallocate(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+  Deallocate(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+  Deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t,
+                     const std::nothrow_t&) noexcept {
+  Deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t,
+                       const std::nothrow_t&) noexcept {
+  Deallocate(ptr);
+}
+
+int main(int argc, char** argv) {
+  int rounds = 5;
+  if (argc > 1) {
+    rounds = std::atoi(argv[1]);
+  }
+
+  if (rounds < 1) {
+    std::cerr << "Usage: " << argv[0] << " [rounds], with at least one round"
+              << std::endl;
+    return 2;
+  }
+
+  // Loads the game data outside of any measurement.
+  std::vector<int> all_items = GetAllItems();
+
+  std::vector<BenchConfig> configs;
+  for (DoorShuffleMode door_shuffle_mode :
+       {kNO_DOORS, kSIMPLE_DOORS, kCOMPLEX_DOORS}) {
+    for (bool color_shuffle : {false, true}) {
+      for (bool painting_shuffle : {false, true}) {
+        for (VictoryCondition victory_condition : {kTHE_END, kLEVEL_2}) {
+          for (LocationChecks location_checks :
+               {kNORMAL_LOCATIONS, kREDUCED_LOCATIONS, kPANELSANITY}) {
+            std::ostringstream name;
+            name << (door_shuffle_mode == kNO_DOORS       ? "doors=none"
+                     : door_shuffle_mode == kSIMPLE_DOORS ? "doors=simple"
+                                                          : "doors=complex")
+                 << (color_shuffle ? " colors" : "")
+                 << (painting_shuffle ? " paintings" : "")
+                 << (victory_condition == kLEVEL_2 ? " level2" : "")
+                 << (location_checks == kREDUCED_LOCATIONS ? " reduced"
+                     : location_checks == kPANELSANITY     ? " panelsanity"
+                                                           : "");
+
+            configs.push_back({.name = name.str(),
+                               .door_shuffle_mode = door_shuffle_mode,
+                               .color_shuffle = color_shuffle,
+                               .painting_shuffle = painting_shuffle,
+                               .victory_condition = victory_condition,
+                               .location_checks = location_checks});
+          }
+        }
+      }
+    }
+  }
+
+  std::cout << std::left << std::setw(68) << "configuration (microseconds)"
+            << std::right << std::setw(10) << "p50" << std::setw(10) << "p90"
+            << std::setw(10) << "p99" << std::setw(10) << "max"
+            << std::setw(12) << "allocs/run" << std::endl;
+
+  // Set if a steady-state recalculation allocated anything.
+  bool steady_state_allocated = false;
+
+  for (const BenchConfig& config : configs) {
+    std::vector<Sample> full_samples;
+    std::vector<Sample> item_samples;
+    std::vector<Sample> steady_samples;
+    std::vector<Sample> analysis_samples;
+
+    for (int round = 0; round < rounds; round++) {
+      std::mt19937 rng(round);
+
+      BenchSlot& slot = GetBenchSlot();
+      slot.door_shuffle_mode = config.door_shuffle_mode;
+      slot.color_shuffle = config.color_shuffle;
+      slot.painting_shuffle = config.painting_shuffle;
+      slot.victory_condition = config.victory_condition;
+      slot.location_checks = config.location_checks;
+      slot.painting_exits.clear();
+      slot.inventory.clear();
+
+      if (config.painting_shuffle) {
+        slot.painting_exits = ShufflePaintings(rng);
+      }
+
+      std::vector<int> item_order = all_items;
+      std::shuffle(item_order.begin(), item_order.end(), rng);
+
+      // Full recalculations at increasingly large inventories.
+      for (int quarter = 0; quarter <= 4; quarter++) {
+        slot.inventory.clear();
+        for (size_t i = 0; i < item_order.size() * quarter / 4; i++) {
+          slot.inventory[item_order.at(i)]++;
+        }
+
+        full_samples.push_back(Measure([]() {
+          ResetReachabilityRequirements();
+          RecalculateReachability();
+        }));
+      }
+
+      // Incremental recalculations, receiving one item at a time.
+      slot.inventory.clear();
+      ResetReachabilityRequirements();
+      RecalculateReachability();
+
+      for (size_t i = 0; i < item_order.size(); i++) {
+        slot.inventory[item_order.at(i)]++;
+        item_samples.push_back(Measure([]() { RecalculateReachability(); }));
+
+        // The item analysis, halfway through the item pool.
+        if (i == item_order.size() / 2) {
+          analysis_samples.push_back(Measure(
+              []() { AnalyzeItemUnlocks([]() { return false; }); }));
+        }
+      }
+
+      // The same items again on the same slot, now that every buffer has
+      // grown to the size it needs. These should not allocate at all.
+      slot.inventory.clear();
+      ResetReachabilityRequirements();
+      RecalculateReachability();
+
+      for (size_t i = 0; i < item_order.size(); i++) {
+        slot.inventory[item_order.at(i)]++;
+        steady_samples.push_back(Measure([]() { RecalculateReachability(); }));
+
+        if (steady_samples.back().allocations > 0) {
+          steady_state_allocated = true;
+        }
+      }
+    }
+
+    Report(config.name + " (full)", full_samples);
+    Report(config.name + " (per item)", item_samples);
+    Report(config.name + " (steady state)", steady_samples);
+    Report(config.name + " (item analysis)", analysis_samples);
+  }
+
+  if (steady_state_allocated) {
+    std::cerr << "Steady-state recalculations allocated memory." << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
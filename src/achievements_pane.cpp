@@ -8,7 +8,7 @@ AchievementsPane::AchievementsPane(wxWindow* parent)
   AppendColumn("Achievement");
 
   for (int panel_id : GD_GetAchievementPanels()) {
-    achievement_names_.push_back(GD_GetPanel(panel_id).achievement_name);
+    achievement_names_.emplace_back(GD_GetPanel(panel_id).achievement_name);
   }
 
   std::sort(std::begin(achievement_names_), std::end(achievement_names_));
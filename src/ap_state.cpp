@@ -9,9 +9,11 @@
 #include <apclient.hpp>
 #include <apuuid.hpp>
 #include <chrono>
+#include <condition_variable>
 #include <exception>
 #include <filesystem>
 #include <list>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <set>
@@ -48,6 +50,10 @@ struct APState {
   std::string data_storage_prefix;
   std::list<std::string> tracked_data_storage_keys;
 
+  // Guards the state below that is written on the poll thread and read by the
+  // reachability worker and the UI.
+  std::mutex state_mutex;
+
   std::map<int64_t, int> inventory;
   std::set<int64_t> checked_locations;
   std::map<std::string, bool> data_storage;
@@ -61,7 +67,20 @@ struct APState {
   VictoryCondition victory_condition = kTHE_END;
   bool early_color_hallways = false;
 
-  std::map<std::string, std::string> painting_mapping;
+  // The exits created by painting shuffle, indexed by the room that they lead
+  // out of.
+  std::vector<std::vector<Exit>> painting_exits;
+
+  // Refresh requests that the reachability worker has not picked up yet. Any
+  // number of requests made while the worker is busy result in one refresh.
+  std::mutex refresh_mutex;
+  std::condition_variable refresh_cv;
+  bool refresh_pending = false;
+  bool reset_pending = false;
+
+  // Set when something that is displayed but not part of the reachability
+  // snapshot has changed, such as the achievements.
+  bool redisplay_pending = false;
 
   void Connect(std::string server, std::string player, std::string password) {
     if (!initialized) {
@@ -80,9 +99,49 @@ struct APState {
         }
       }).detach();
 
+      std::thread([this]() {
+        for (;;) {
+          bool reset = false;
+          bool redisplay = false;
+          {
+            std::unique_lock refresh_lock(refresh_mutex);
+            refresh_cv.wait(refresh_lock, [this]() { return refresh_pending; });
+
+            reset = reset_pending;
+            redisplay = redisplay_pending;
+            refresh_pending = false;
+            reset_pending = false;
+            redisplay_pending = false;
+          }
+
+          TrackerLog("Refreshing display...");
+
+          if (reset) {
+            ResetReachabilityRequirements();
+          }
+
+          // Most refreshes don't change anything that is displayed, and those
+          // don't need to be redrawn.
+          if (RecalculateReachability() || redisplay) {
+            tracker_frame->UpdateIndicators();
+          }
+
+          // The item analysis takes much longer than the recalculation, so it
+          // is abandoned as soon as there is a newer refresh to handle. It is
+          // skipped if nothing has changed since the last one.
+          if (AnalyzeItemUnlocks([this]() {
+                std::lock_guard refresh_guard(refresh_mutex);
+                return refresh_pending;
+              })) {
+            tracker_frame->UpdateItemUnlocks();
+          }
+        }
+      }).detach();
+
       for (int panel_id : GD_GetAchievementPanels()) {
         tracked_data_storage_keys.push_back(
-            "Achievement|" + GD_GetPanel(panel_id).achievement_name);
+            "Achievement|" +
+            std::string(GD_GetPanel(panel_id).achievement_name));
       }
 
       initialized = true;
@@ -109,24 +168,31 @@ struct APState {
                                             cert_store);
     }
 
-    inventory.clear();
-    checked_locations.clear();
-    data_storage.clear();
-    door_shuffle_mode = kNO_DOORS;
-    color_shuffle = false;
-    painting_shuffle = false;
-    painting_mapping.clear();
-    mastery_requirement = 21;
-    level_2_requirement = 223;
-    location_checks = kNORMAL_LOCATIONS;
-    victory_condition = kTHE_END;
-    early_color_hallways = false;
+    {
+      std::lock_guard state_guard(state_mutex);
+
+      inventory.clear();
+      checked_locations.clear();
+      data_storage.clear();
+      door_shuffle_mode = kNO_DOORS;
+      color_shuffle = false;
+      painting_shuffle = false;
+      painting_exits.clear();
+      mastery_requirement = 21;
+      level_2_requirement = 223;
+      location_checks = kNORMAL_LOCATIONS;
+      victory_condition = kTHE_END;
+      early_color_hallways = false;
+    }
 
     connected = false;
     has_connection_result = false;
 
     apclient->set_room_info_handler([this, player, password]() {
-      inventory.clear();
+      {
+        std::lock_guard state_guard(state_mutex);
+        inventory.clear();
+      }
 
       TrackerLog("Connected to Archipelago server. Authenticating as " +
                  player +
@@ -141,12 +207,16 @@ struct APState {
 
     apclient->set_location_checked_handler(
         [this](const std::list<int64_t>& locations) {
-          for (const int64_t location_id : locations) {
-            checked_locations.insert(location_id);
-            TrackerLog("Location: " + std::to_string(location_id));
+          {
+            std::lock_guard state_guard(state_mutex);
+
+            for (const int64_t location_id : locations) {
+              checked_locations.insert(location_id);
+              TrackerLog("Location: " + std::to_string(location_id));
+            }
           }
 
-          RefreshTracker();
+          RefreshTracker(/*reset=*/false);
         });
 
     apclient->set_slot_disconnected_handler([this]() {
@@ -165,36 +235,48 @@ struct APState {
 
     apclient->set_items_received_handler(
         [this](const std::list<APClient::NetworkItem>& items) {
-          for (const APClient::NetworkItem& item : items) {
-            inventory[item.item]++;
-            TrackerLog("Item: " + std::to_string(item.item));
+          {
+            std::lock_guard state_guard(state_mutex);
+
+            for (const APClient::NetworkItem& item : items) {
+              inventory[item.item]++;
+              TrackerLog("Item: " + std::to_string(item.item));
+            }
           }
 
-          RefreshTracker();
+          RefreshTracker(/*reset=*/false);
         });
 
     apclient->set_retrieved_handler(
         [this](const std::map<std::string, nlohmann::json>& data) {
-          for (const auto& [key, value] : data) {
-            if (value.is_boolean()) {
-              data_storage[key] = value.get<bool>();
-              TrackerLog("Data storage " + key + " retrieved as " +
-                         (value.get<bool>() ? "true" : "false"));
+          {
+            std::lock_guard state_guard(state_mutex);
+
+            for (const auto& [key, value] : data) {
+              if (value.is_boolean()) {
+                data_storage[key] = value.get<bool>();
+                TrackerLog("Data storage " + key + " retrieved as " +
+                           (value.get<bool>() ? "true" : "false"));
+              }
             }
           }
 
-          RefreshTracker();
+          RefreshTracker(/*reset=*/false, /*redisplay=*/true);
         });
 
     apclient->set_set_reply_handler([this](const std::string& key,
                                            const nlohmann::json& value,
                                            const nlohmann::json&) {
       if (value.is_boolean()) {
-        data_storage[key] = value.get<bool>();
+        {
+          std::lock_guard state_guard(state_mutex);
+          data_storage[key] = value.get<bool>();
+        }
+
         TrackerLog("Data storage " + key + " set to " +
                    (value.get<bool>() ? "true" : "false"));
 
-        RefreshTracker();
+        RefreshTracker(/*reset=*/false, /*redisplay=*/true);
       }
     });
 
@@ -203,32 +285,51 @@ struct APState {
       tracker_frame->SetStatusMessage("Connected to Archipelago!");
       TrackerLog("Connected to Archipelago!");
 
-      data_storage_prefix =
-          "Lingo_" + std::to_string(apclient->get_player_number()) + "_";
-      door_shuffle_mode = slot_data["shuffle_doors"].get<DoorShuffleMode>();
-      color_shuffle = slot_data["shuffle_colors"].get<int>() == 1;
-      painting_shuffle = slot_data["shuffle_paintings"].get<int>() == 1;
-      mastery_requirement = slot_data["mastery_achievements"].get<int>();
-      level_2_requirement = slot_data["level_2_requirement"].get<int>();
-      location_checks = slot_data["location_checks"].get<LocationChecks>();
-      victory_condition =
-          slot_data["victory_condition"].get<VictoryCondition>();
-      early_color_hallways = slot_data.contains("early_color_hallways") &&
-                             slot_data["early_color_hallways"].get<int>() == 1;
-
-      if (painting_shuffle && slot_data.contains("painting_entrance_to_exit")) {
-        painting_mapping.clear();
-
-        for (const auto& mapping_it :
-             slot_data["painting_entrance_to_exit"].items()) {
-          painting_mapping[mapping_it.key()] = mapping_it.value();
+      {
+        std::lock_guard state_guard(state_mutex);
+
+        data_storage_prefix =
+            "Lingo_" + std::to_string(apclient->get_player_number()) + "_";
+        door_shuffle_mode = slot_data["shuffle_doors"].get<DoorShuffleMode>();
+        color_shuffle = slot_data["shuffle_colors"].get<int>() == 1;
+        painting_shuffle = slot_data["shuffle_paintings"].get<int>() == 1;
+        mastery_requirement = slot_data["mastery_achievements"].get<int>();
+        level_2_requirement = slot_data["level_2_requirement"].get<int>();
+        location_checks = slot_data["location_checks"].get<LocationChecks>();
+        victory_condition =
+            slot_data["victory_condition"].get<VictoryCondition>();
+        early_color_hallways =
+            slot_data.contains("early_color_hallways") &&
+            slot_data["early_color_hallways"].get<int>() == 1;
+
+        painting_exits.clear();
+        painting_exits.resize(GD_GetRooms().size());
+
+        if (painting_shuffle &&
+            slot_data.contains("painting_entrance_to_exit")) {
+          const nlohmann::json& painting_mapping =
+              slot_data["painting_entrance_to_exit"];
+
+          for (int room_id = 0; room_id < painting_exits.size(); room_id++) {
+            for (const PaintingExit& painting :
+                 GD_GetRoom(room_id).paintings) {
+              std::string painting_id(painting.id);
+              if (painting_mapping.contains(painting_id)) {
+                painting_exits[room_id].push_back(
+                    {.destination_room = GD_GetRoomForPainting(
+                         painting_mapping[painting_id].get<std::string>()),
+                     .door = painting.door,
+                     .painting = true});
+              }
+            }
+          }
         }
       }
 
       connected = true;
       has_connection_result = true;
 
-      RefreshTracker();
+      RefreshTracker(/*reset=*/true);
 
       std::list<std::string> corrected_keys;
       for (const std::string& key : tracked_data_storage_keys) {
@@ -301,30 +402,73 @@ struct APState {
     }
 
     if (connected) {
-      RefreshTracker();
+      RefreshTracker(/*reset=*/false);
     } else {
       client_active = false;
     }
   }
 
   bool HasCheckedGameLocation(int location_id) {
+    std::lock_guard state_guard(state_mutex);
     return checked_locations.count(location_id);
   }
 
   bool HasItem(int item_id, int quantity) {
+    std::lock_guard state_guard(state_mutex);
     return inventory.count(item_id) && inventory.at(item_id) >= quantity;
   }
 
+  void VisitInventory(
+      const std::function<void(int64_t ap_item_id, int count)>& visitor) {
+    std::lock_guard state_guard(state_mutex);
+    for (const auto& [ap_item_id, count] : inventory) {
+      visitor(ap_item_id, count);
+    }
+  }
+
   bool HasAchievement(const std::string& name) {
+    std::lock_guard state_guard(state_mutex);
     std::string key = data_storage_prefix + "Achievement|" + name;
     return data_storage.count(key) && data_storage.at(key);
   }
 
-  void RefreshTracker() {
-    TrackerLog("Refreshing display...");
+  std::vector<std::vector<Exit>> GetPaintingExits() {
+    std::lock_guard state_guard(state_mutex);
+    return painting_exits;
+  }
 
-    RecalculateReachability();
-    tracker_frame->UpdateIndicators();
+  // The slot options are written by the poll thread when a slot connects, and
+  // read by the UI and the reachability worker.
+  template <typename T>
+  T GetSlotOption(const T& option) {
+    std::lock_guard state_guard(state_mutex);
+    return option;
+  }
+
+  bool IsLocationVisible(int classification) {
+    switch (GetSlotOption(location_checks)) {
+      case kNORMAL_LOCATIONS:
+        return classification & kLOCATION_NORMAL;
+      case kREDUCED_LOCATIONS:
+        return classification & kLOCATION_REDUCED;
+      case kPANELSANITY:
+        return classification & kLOCATION_INSANITY;
+      default:
+        return false;
+    }
+  }
+
+  // Hands a refresh to the reachability worker. This never blocks on the logic
+  // evaluation, so it is safe to call from the poll thread.
+  void RefreshTracker(bool reset, bool redisplay = false) {
+    {
+      std::lock_guard refresh_guard(refresh_mutex);
+      refresh_pending = true;
+      reset_pending |= reset;
+      redisplay_pending |= redisplay;
+    }
+
+    refresh_cv.notify_one();
   }
 
   int64_t GetItemId(const std::string& item_name) {
@@ -364,39 +508,47 @@ bool AP_HasItem(int item_id, int quantity) {
   return GetState().HasItem(item_id, quantity);
 }
 
-DoorShuffleMode AP_GetDoorShuffleMode() { return GetState().door_shuffle_mode; }
+void AP_VisitInventory(
+    const std::function<void(int64_t ap_item_id, int count)>& visitor) {
+  GetState().VisitInventory(visitor);
+}
 
-bool AP_IsColorShuffle() { return GetState().color_shuffle; }
+DoorShuffleMode AP_GetDoorShuffleMode() {
+  return GetState().GetSlotOption(GetState().door_shuffle_mode);
+}
 
-bool AP_IsPaintingShuffle() { return GetState().painting_shuffle; }
+bool AP_IsColorShuffle() {
+  return GetState().GetSlotOption(GetState().color_shuffle);
+}
 
-const std::map<std::string, std::string> AP_GetPaintingMapping() {
-  return GetState().painting_mapping;
+bool AP_IsPaintingShuffle() {
+  return GetState().GetSlotOption(GetState().painting_shuffle);
 }
 
-int AP_GetMasteryRequirement() { return GetState().mastery_requirement; }
+std::vector<std::vector<Exit>> AP_GetPaintingExits() {
+  return GetState().GetPaintingExits();
+}
+
+int AP_GetMasteryRequirement() {
+  return GetState().GetSlotOption(GetState().mastery_requirement);
+}
 
-int AP_GetLevel2Requirement() { return GetState().level_2_requirement; }
+int AP_GetLevel2Requirement() {
+  return GetState().GetSlotOption(GetState().level_2_requirement);
+}
 
 bool AP_IsLocationVisible(int classification) {
-  switch (GetState().location_checks) {
-    case kNORMAL_LOCATIONS:
-      return classification & kLOCATION_NORMAL;
-    case kREDUCED_LOCATIONS:
-      return classification & kLOCATION_REDUCED;
-    case kPANELSANITY:
-      return classification & kLOCATION_INSANITY;
-    default:
-      return false;
-  }
+  return GetState().IsLocationVisible(classification);
 }
 
 VictoryCondition AP_GetVictoryCondition() {
-  return GetState().victory_condition;
+  return GetState().GetSlotOption(GetState().victory_condition);
 }
 
 bool AP_HasAchievement(const std::string& achievement_name) {
   return GetState().HasAchievement(achievement_name);
 }
 
-bool AP_HasEarlyColorHallways() { return GetState().early_color_hallways; }
+bool AP_HasEarlyColorHallways() {
+  return GetState().GetSlotOption(GetState().early_color_hallways);
+}
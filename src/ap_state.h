@@ -1,8 +1,10 @@
 #ifndef AP_STATE_H_664A4180
 #define AP_STATE_H_664A4180
 
-#include <map>
+#include <cstdint>
+#include <functional>
 #include <string>
+#include <vector>
 
 #include "game_data.h"
 
@@ -22,13 +24,21 @@ bool AP_HasCheckedGameLocation(int location_id);
 
 bool AP_HasItem(int item_id, int quantity = 1);
 
+// Calls the visitor with each item that has been received so far and how many
+// of it there are. The inventory is locked in the meantime, so the visitor must
+// not call back into AP_*.
+void AP_VisitInventory(
+    const std::function<void(int64_t ap_item_id, int count)>& visitor);
+
 DoorShuffleMode AP_GetDoorShuffleMode();
 
 bool AP_IsColorShuffle();
 
 bool AP_IsPaintingShuffle();
 
-const std::map<std::string, std::string> AP_GetPaintingMapping();
+// Returns the exits created by painting shuffle, indexed by the room that they
+// lead out of. These are resolved once, when the slot connects.
+std::vector<std::vector<Exit>> AP_GetPaintingExits();
 
 int AP_GetMasteryRequirement();
 
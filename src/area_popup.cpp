@@ -1,5 +1,10 @@
 #include "area_popup.h"
 
+#include <algorithm>
+#include <iterator>
+#include <set>
+#include <string>
+
 #include "ap_state.h"
 #include "game_data.h"
 #include "tracker_state.h"
@@ -15,7 +20,8 @@ AreaPopup::AreaPopup(wxWindow* parent, int area_id)
     section_sizer->Add(eye_indicator, wxSizerFlags().Expand());
     eye_indicators_.push_back(eye_indicator);
 
-    wxStaticText* section_label = new wxStaticText(this, -1, location.name);
+    wxStaticText* section_label =
+        new wxStaticText(this, -1, std::string(location.name));
     section_label->SetForegroundColour(*wxWHITE);
     section_sizer->Add(
         section_label,
@@ -25,7 +31,8 @@ AreaPopup::AreaPopup(wxWindow* parent, int area_id)
 
   wxBoxSizer* top_sizer = new wxBoxSizer(wxVERTICAL);
 
-  wxStaticText* top_label = new wxStaticText(this, -1, map_area.name);
+  wxStaticText* top_label =
+      new wxStaticText(this, -1, std::string(map_area.name));
   top_label->SetForegroundColour(*wxWHITE);
   top_label->SetFont(top_label->GetFont().Bold());
   top_sizer->Add(top_label,
@@ -33,6 +40,11 @@ AreaPopup::AreaPopup(wxWindow* parent, int area_id)
 
   top_sizer->Add(section_sizer, wxSizerFlags().DoubleBorder(wxALL).Expand());
 
+  critical_doors_label_ = new wxStaticText(this, -1, "");
+  critical_doors_label_->SetForegroundColour(*wxWHITE);
+  top_sizer->Add(critical_doors_label_,
+                 wxSizerFlags().DoubleBorder(wxDOWN | wxLEFT | wxRIGHT));
+
   SetSizerAndFit(top_sizer);
   SetScrollRate(5, 5);
 
@@ -40,15 +52,24 @@ AreaPopup::AreaPopup(wxWindow* parent, int area_id)
   Hide();
 }
 
-void AreaPopup::UpdateIndicators() {
+void AreaPopup::UpdateIndicators(const ReachabilitySnapshot& reachability) {
   const MapArea& map_area = GD_GetMapArea(area_id_);
+
+  // The closed doors that stand in the way of every unreachable location in
+  // the area, regardless of which route is taken to it. Only the doors that
+  // are opened by an item are listed, which leaves none without door shuffle.
+  DoorShuffleMode door_shuffle_mode = AP_GetDoorShuffleMode();
+  const HotGameData& hot_data = GD_GetHotData();
+  std::vector<int> critical_doors;
+  bool any_unreachable = false;
+
   for (int section_id = 0; section_id < map_area.locations.size();
        section_id++) {
     const Location& location = map_area.locations.at(section_id);
     wxSizer* container_sizer =
         section_labels_[section_id]->GetContainingSizer();
 
-    if (!AP_IsLocationVisible(location.classification)) {
+    if (!AP_IsLocationVisible(hot_data.location_classifications[location.id])) {
       container_sizer->Hide(section_labels_[section_id]);
       container_sizer->Hide(eye_indicators_[section_id]);
       continue;
@@ -57,12 +78,71 @@ void AreaPopup::UpdateIndicators() {
       container_sizer->Show(eye_indicators_[section_id]);
     }
 
-    bool checked = AP_HasCheckedGameLocation(location.ap_location_id);
-    bool reachable = IsLocationReachable(location.ap_location_id);
-    const wxColour* text_color = reachable ? wxWHITE : wxRED;
+    bool checked = reachability.checked_locations.Test(location.id);
+    bool reachable = reachability.reachable_locations.Test(location.id);
+    wxColour text_color = reachable ? *wxWHITE : *wxRED;
+    if (!reachable && reachability.out_of_logic_locations.Test(location.id)) {
+      text_color = wxTheColourDatabase->Find("ORANGE");
+    }
+
+    std::string label_text(location.name);
+    int sphere_depth = reachability.sphere_depths.at(location.id);
+    if (!reachable && sphere_depth > 0) {
+      label_text += " (sphere " + std::to_string(sphere_depth) + ")";
+    }
 
-    section_labels_[section_id]->SetForegroundColour(*text_color);
+    section_labels_[section_id]->SetLabel(label_text);
+    section_labels_[section_id]->SetForegroundColour(text_color);
     eye_indicators_[section_id]->SetChecked(checked);
+
+    if (!reachable && !checked && reachability.dominators &&
+        door_shuffle_mode != kNO_DOORS) {
+      std::vector<int> location_doors =
+          reachability.dominators->GetCriticalDoors(
+              hot_data.location_rooms[location.id]);
+      std::erase_if(location_doors, [&reachability, &hot_data](int door_id) {
+        return reachability.open_doors.Test(door_id) ||
+               hot_data.door_skip_item[door_id];
+      });
+      std::sort(location_doors.begin(), location_doors.end());
+
+      if (!any_unreachable) {
+        critical_doors = std::move(location_doors);
+        any_unreachable = true;
+      } else {
+        std::vector<int> common_doors;
+        std::set_intersection(critical_doors.begin(), critical_doors.end(),
+                              location_doors.begin(), location_doors.end(),
+                              std::back_inserter(common_doors));
+        critical_doors = std::move(common_doors);
+      }
+    }
+  }
+
+  if (critical_doors.empty()) {
+    critical_doors_label_->Hide();
+  } else {
+    // Doors in the same group are opened by the same item in simple doors.
+    std::set<std::string> door_names;
+    for (int door_id : critical_doors) {
+      const Door& door = GD_GetDoor(door_id);
+      if (door_shuffle_mode == kSIMPLE_DOORS && !door.group_name.empty()) {
+        door_names.emplace(door.group_name);
+      } else if (!door.item_name.empty()) {
+        door_names.emplace(door.item_name);
+      } else {
+        door_names.insert(std::string(GD_GetRoom(door.room).name) + " - " +
+                          std::string(door.name));
+      }
+    }
+
+    std::string critical_text = "Needs:";
+    for (const std::string& door_name : door_names) {
+      critical_text += "\n" + door_name;
+    }
+
+    critical_doors_label_->SetLabel(critical_text);
+    critical_doors_label_->Show();
   }
 
   section_labels_[0]->GetContainingSizer()->Layout();
@@ -9,17 +9,20 @@
 
 #include "eye_indicator.h"
 
+struct ReachabilitySnapshot;
+
 class AreaPopup : public wxScrolledWindow {
  public:
   AreaPopup(wxWindow* parent, int area_id);
 
-  void UpdateIndicators();
+  void UpdateIndicators(const ReachabilitySnapshot& reachability);
 
  private:
   int area_id_;
 
   std::vector<wxStaticText*> section_labels_;
   std::vector<EyeIndicator*> eye_indicators_;
+  wxStaticText* critical_doors_label_;
 };
 
 #endif /* end of include guard: AREA_POPUP_H_03FAC988 */
@@ -0,0 +1,148 @@
+#ifndef DENSE_BITSET_H_5B0E2F7A
+#define DENSE_BITSET_H_5B0E2F7A
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <span>
+#include <utility>
+#include <vector>
+
+// A fixed-size set of small non-negative integers, such as room or panel IDs,
+// stored one bit per element.
+class DenseBitset {
+ public:
+  // A precomputed set of indices, grouped by word so that it can be tested
+  // against a DenseBitset one word at a time.
+  class Mask {
+   public:
+    Mask() = default;
+
+    explicit Mask(std::initializer_list<int> indices)
+        : Mask(std::span<const int>(indices.begin(), indices.size())) {}
+
+    explicit Mask(std::span<const int> indices) {
+      for (int index : indices) {
+        size_t word = WordFor(index);
+        uint64_t bit = BitFor(index);
+
+        auto it = words_.begin();
+        while (it != words_.end() && it->first < word) {
+          ++it;
+        }
+
+        if (it != words_.end() && it->first == word) {
+          it->second |= bit;
+        } else {
+          words_.insert(it, {word, bit});
+        }
+      }
+    }
+
+    bool empty() const { return words_.empty(); }
+
+    // The (word index, bits) pairs that make up the mask, by word index.
+    const std::vector<std::pair<size_t, uint64_t>>& words() const {
+      return words_;
+    }
+
+   private:
+    friend class DenseBitset;
+
+    std::vector<std::pair<size_t, uint64_t>> words_;
+  };
+
+  DenseBitset() = default;
+
+  explicit DenseBitset(size_t size) { Resize(size); }
+
+  // Resizes the set and removes every element from it.
+  void Resize(size_t size) {
+    size_ = size;
+    words_.assign((size + 63) / 64, 0);
+  }
+
+  size_t size() const { return size_; }
+
+  bool Test(int index) const {
+    return words_[WordFor(index)] & BitFor(index);
+  }
+
+  void Set(int index) { words_[WordFor(index)] |= BitFor(index); }
+
+  uint64_t word(size_t word_index) const { return words_[word_index]; }
+
+  void Reset() { std::fill(words_.begin(), words_.end(), 0); }
+
+  // Adds every element, up to the size of the set.
+  void SetAll() {
+    std::fill(words_.begin(), words_.end(), ~uint64_t{0});
+    if (size_ % 64 != 0) {
+      words_.back() &= BitFor(size_) - 1;
+    }
+  }
+
+  bool Any() const {
+    return std::any_of(words_.begin(), words_.end(),
+                       [](uint64_t word) { return word != 0; });
+  }
+
+  // Both sets have to be the same size.
+  DenseBitset& operator|=(const DenseBitset& other) {
+    for (size_t word = 0; word < words_.size(); word++) {
+      words_[word] |= other.words_[word];
+    }
+
+    return *this;
+  }
+
+  // Removes every element of the other set, which has to be the same size.
+  void RemoveAll(const DenseBitset& other) {
+    for (size_t word = 0; word < words_.size(); word++) {
+      words_[word] &= ~other.words_[word];
+    }
+  }
+
+  DenseBitset& operator^=(const DenseBitset& other) {
+    for (size_t word = 0; word < words_.size(); word++) {
+      words_[word] ^= other.words_[word];
+    }
+
+    return *this;
+  }
+
+  bool ContainsAll(const Mask& mask) const {
+    for (const auto& [word, bits] : mask.words_) {
+      if ((words_[word] & bits) != bits) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  int CountMatching(const Mask& mask) const {
+    int count = 0;
+    for (const auto& [word, bits] : mask.words_) {
+      count += std::popcount(words_[word] & bits);
+    }
+
+    return count;
+  }
+
+  bool operator==(const DenseBitset& other) const = default;
+
+ private:
+  static size_t WordFor(int index) { return static_cast<size_t>(index) / 64; }
+
+  static uint64_t BitFor(int index) {
+    return uint64_t{1} << (static_cast<size_t>(index) % 64);
+  }
+
+  size_t size_ = 0;
+  std::vector<uint64_t> words_;
+};
+
+#endif /* end of include guard: DENSE_BITSET_H_5B0E2F7A */
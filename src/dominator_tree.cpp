@@ -0,0 +1,146 @@
+#include "dominator_tree.h"
+
+#include <algorithm>
+#include <map>
+#include <utility>
+
+DominatorTree::DominatorTree(const ExitTable& exit_table,
+                             const std::vector<int>& start_rooms)
+    : component_count_(exit_table.component_exit_offsets.size() - 1),
+      room_component_(exit_table.room_component) {
+  auto component_node = [this](int room_id) {
+    return 1 + room_component_[room_id];
+  };
+
+  int node_count = 1 + component_count_;
+  node_door_.assign(node_count, -1);
+
+  std::vector<std::vector<int>> successors(node_count);
+  for (int room_id : start_rooms) {
+    successors[0].push_back(component_node(room_id));
+  }
+
+  // Exits that share a door and lead into the same component share a node,
+  // so that the door counts as unavoidable even if there are several ways
+  // through it.
+  std::map<std::pair<int, int>, int> door_nodes;
+
+  for (const CompiledExit& room_exit : exit_table.exits) {
+    int source_node = component_node(room_exit.source_room);
+    int destination_node = component_node(room_exit.destination_room);
+
+    if (room_exit.door == -1) {
+      successors[source_node].push_back(destination_node);
+    } else {
+      auto [door_node, inserted] = door_nodes.try_emplace(
+          {room_exit.door, destination_node}, node_count);
+      if (inserted) {
+        successors.push_back({destination_node});
+        node_door_.push_back(room_exit.door);
+        node_count++;
+      }
+
+      successors[source_node].push_back(door_node->second);
+    }
+  }
+
+  // Number the nodes in postorder, with an iterative depth-first search.
+  std::vector<int> postorder_index(node_count, -1);
+  std::vector<int> postorder;
+  std::vector<bool> visited(node_count, false);
+  std::vector<std::pair<int, size_t>> call_stack = {{0, 0}};
+  visited[0] = true;
+
+  while (!call_stack.empty()) {
+    auto [node, edge_index] = call_stack.back();
+
+    if (edge_index < successors[node].size()) {
+      call_stack.back().second++;
+
+      int next_node = successors[node][edge_index];
+      if (!visited[next_node]) {
+        visited[next_node] = true;
+        call_stack.push_back({next_node, 0});
+      }
+    } else {
+      postorder_index[node] = postorder.size();
+      postorder.push_back(node);
+      call_stack.pop_back();
+    }
+  }
+
+  std::vector<std::vector<int>> predecessors(node_count);
+  for (int node = 0; node < node_count; node++) {
+    for (int next_node : successors[node]) {
+      predecessors[next_node].push_back(node);
+    }
+  }
+
+  // Cooper, Harvey and Kennedy's iterative algorithm, which visits the nodes
+  // in reverse postorder until nothing changes.
+  immediate_dominator_.assign(node_count, -1);
+  immediate_dominator_[0] = 0;
+
+  auto intersect = [this, &postorder_index](int lhs, int rhs) {
+    while (lhs != rhs) {
+      while (postorder_index[lhs] < postorder_index[rhs]) {
+        lhs = immediate_dominator_[lhs];
+      }
+
+      while (postorder_index[rhs] < postorder_index[lhs]) {
+        rhs = immediate_dominator_[rhs];
+      }
+    }
+
+    return lhs;
+  };
+
+  bool changed = true;
+  while (changed) {
+    changed = false;
+
+    for (auto it = postorder.rbegin(); it != postorder.rend(); ++it) {
+      int node = *it;
+      if (node == 0) {
+        continue;
+      }
+
+      int new_dominator = -1;
+      for (int predecessor : predecessors[node]) {
+        if (immediate_dominator_[predecessor] == -1) {
+          continue;
+        }
+
+        new_dominator = new_dominator == -1
+                            ? predecessor
+                            : intersect(predecessor, new_dominator);
+      }
+
+      if (new_dominator != immediate_dominator_[node]) {
+        immediate_dominator_[node] = new_dominator;
+        changed = true;
+      }
+    }
+  }
+}
+
+std::vector<int> DominatorTree::GetCriticalDoors(int room_id) const {
+  std::vector<int> doors;
+
+  int node = 1 + room_component_[room_id];
+  if (immediate_dominator_[node] == -1) {
+    return doors;
+  }
+
+  while (node != 0) {
+    if (node_door_[node] != -1 &&
+        std::find(doors.begin(), doors.end(), node_door_[node]) ==
+            doors.end()) {
+      doors.push_back(node_door_[node]);
+    }
+
+    node = immediate_dominator_[node];
+  }
+
+  return doors;
+}
@@ -0,0 +1,33 @@
+#ifndef DOMINATOR_TREE_H_71D4B0A5
+#define DOMINATOR_TREE_H_71D4B0A5
+
+#include <vector>
+
+#include "requirement_graph.h"
+
+// The dominator tree of the room graph, built over the components of an exit
+// table. Exits with a door get a node of their own, so that the tree can tell
+// which doors every route from the start to a room has to go through. A door
+// that gates exits into several components is only reported where one of
+// those exits is unavoidable. Doors are treated as passable whether they are
+// open or not, so this only needs to be rebuilt when the exit table changes.
+class DominatorTree {
+ public:
+  DominatorTree(const ExitTable& exit_table,
+                const std::vector<int>& start_rooms);
+
+  // The doors that every route to the room goes through, nearest first. Empty
+  // if the room can't be reached at all.
+  std::vector<int> GetCriticalDoors(int room_id) const;
+
+ private:
+  int component_count_;
+
+  // Node 0 is a virtual root with an edge to every start room. It is followed
+  // by one node per component, then one per door and destination component.
+  std::vector<int> room_component_;
+  std::vector<int> node_door_;
+  std::vector<int> immediate_dominator_;
+};
+
+#endif /* end of include guard: DOMINATOR_TREE_H_71D4B0A5 */
@@ -0,0 +1,12 @@
+#ifndef EMBEDDED_GAME_DATA_H_E07C4A92
+#define EMBEDDED_GAME_DATA_H_E07C4A92
+
+#include <string_view>
+
+// The game data image that tools/game_data_compiler.cpp generated from the
+// YAML files at build time. Only exists if LINGO_EMBEDDED_GAME_DATA is set.
+// The structs are still rebuilt from it at startup, but without parsing any
+// YAML, and their names point into it.
+std::string_view GetEmbeddedGameData();
+
+#endif /* end of include guard: EMBEDDED_GAME_DATA_H_E07C4A92 */
@@ -3,13 +3,38 @@
 #include <hkutil/string.h>
 #include <yaml-cpp/yaml.h>
 
+#include <filesystem>
 #include <iostream>
 #include <sstream>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
 
+#include "game_data_cache.h"
 #include "logger.h"
+#include "string_arena.h"
+
+#ifdef LINGO_EMBEDDED_GAME_DATA
+#include "embedded_game_data.h"
+#endif
 
 namespace {
 
+constexpr const char *LINGO_CONFIG_FILE = "assets/LL1.yaml";
+constexpr const char *AREAS_CONFIG_FILE = "assets/areas.yaml";
+constexpr const char *PILGRIMAGE_CONFIG_FILE = "assets/pilgrimage.yaml";
+constexpr const char *IDS_CONFIG_FILE = "assets/ids.yaml";
+constexpr const char *CACHE_FILE_NAME = "game_data.cache";
+
+std::optional<uint64_t> HashSourceFiles() {
+  return HashGameDataFiles({LINGO_CONFIG_FILE, AREAS_CONFIG_FILE,
+                            PILGRIMAGE_CONFIG_FILE, IDS_CONFIG_FILE});
+}
+
+std::filesystem::path GetCachePath() {
+  return GetExecutableDirectory() / CACHE_FILE_NAME;
+}
+
 LingoColor GetColorForString(const std::string &str) {
   if (str == "black") {
     return LingoColor::kBlack;
@@ -38,20 +63,140 @@ LingoColor GetColorForString(const std::string &str) {
   }
 }
 
+// Every ID in ids.yaml, keyed by what kind of ID it is, the room it is in (if
+// any), and its name. yaml-cpp looks up map keys with a linear scan, so this
+// is built once up front rather than walking the document for every ID.
+enum class IdKind {
+  kSpecialItem,
+  kPanel,
+  kDoorItem,
+  kDoorLocation,
+  kDoorGroup,
+  kProgression
+};
+
+class IdIndex {
+ public:
+  explicit IdIndex(const YAML::Node &ids_config) {
+    auto add_all = [this](IdKind kind, const std::string &room,
+                          const YAML::Node &node) {
+      if (!node || !node.IsMap()) {
+        return;
+      }
+
+      for (const auto &id_it : node) {
+        ids_.emplace(Key{kind, room, id_it.first.as<std::string>()},
+                     id_it.second.as<int>());
+      }
+    };
+
+    add_all(IdKind::kSpecialItem, "", ids_config["special_items"]);
+    add_all(IdKind::kDoorGroup, "", ids_config["door_groups"]);
+    add_all(IdKind::kProgression, "", ids_config["progression"]);
+
+    if (ids_config["panels"] && ids_config["panels"].IsMap()) {
+      for (const auto &room_it : ids_config["panels"]) {
+        add_all(IdKind::kPanel, room_it.first.as<std::string>(),
+                room_it.second);
+      }
+    }
+
+    if (ids_config["doors"] && ids_config["doors"].IsMap()) {
+      for (const auto &room_it : ids_config["doors"]) {
+        std::string room_name = room_it.first.as<std::string>();
+        if (!room_it.second.IsMap()) {
+          continue;
+        }
+
+        for (const auto &door_it : room_it.second) {
+          std::string door_name = door_it.first.as<std::string>();
+
+          if (door_it.second["item"]) {
+            ids_.emplace(Key{IdKind::kDoorItem, room_name, door_name},
+                         door_it.second["item"].as<int>());
+          }
+
+          if (door_it.second["location"]) {
+            ids_.emplace(Key{IdKind::kDoorLocation, room_name, door_name},
+                         door_it.second["location"].as<int>());
+          }
+        }
+      }
+    }
+  }
+
+  std::optional<int> Find(IdKind kind, std::string_view room,
+                          std::string_view name) const {
+    auto it = ids_.find(KeyView{kind, room, name});
+    if (it == ids_.end()) {
+      return std::nullopt;
+    }
+
+    return it->second;
+  }
+
+  std::optional<int> Find(IdKind kind, std::string_view name) const {
+    return Find(kind, "", name);
+  }
+
+ private:
+  using Key = std::tuple<IdKind, std::string, std::string>;
+  using KeyView = std::tuple<IdKind, std::string_view, std::string_view>;
+
+  // Lets the index be searched without copying the names into a Key.
+  struct KeyHash {
+    using is_transparent = void;
+
+    size_t operator()(const KeyView &key) const {
+      size_t hash = std::hash<std::string_view>()(std::get<1>(key));
+      hash = hash * 31 + std::hash<std::string_view>()(std::get<2>(key));
+      return hash * 31 + static_cast<size_t>(std::get<0>(key));
+    }
+
+    size_t operator()(const Key &key) const {
+      return (*this)(KeyView(key));
+    }
+  };
+
+  struct KeyEqual {
+    using is_transparent = void;
+
+    bool operator()(const KeyView &lhs, const KeyView &rhs) const {
+      return lhs == rhs;
+    }
+  };
+
+  std::unordered_map<Key, int, KeyHash, KeyEqual> ids_;
+};
+
+// A name within a room, such as that of a door or panel.
+using RoomNameKey = std::pair<int, std::string_view>;
+
+struct RoomNameKeyHash {
+  size_t operator()(const RoomNameKey &key) const {
+    return std::hash<std::string_view>()(key.second) * 31 + key.first;
+  }
+};
+
 struct GameData {
+  // Owns every name that the structs below refer to. The lookup tables are
+  // keyed on views into it, so looking a name up never copies it.
+  StringArena names_;
+
   std::vector<Room> rooms_;
   std::vector<Door> doors_;
   std::vector<Panel> panels_;
   std::vector<MapArea> map_areas_;
+  int location_count_ = 0;
 
-  std::map<std::string, int> room_by_id_;
-  std::map<std::string, int> door_by_id_;
-  std::map<std::string, int> panel_by_id_;
-  std::map<std::string, int> area_by_id_;
+  std::unordered_map<std::string_view, int> room_by_id_;
+  std::unordered_map<RoomNameKey, int, RoomNameKeyHash> door_by_id_;
+  std::unordered_map<RoomNameKey, int, RoomNameKeyHash> panel_by_id_;
+  std::unordered_map<std::string_view, int> area_by_id_;
 
   std::vector<int> door_definition_order_;
 
-  std::map<std::string, int> room_by_painting_;
+  std::unordered_map<std::string_view, int> room_by_painting_;
 
   std::vector<int> achievement_panels_;
 
@@ -60,19 +205,121 @@ struct GameData {
   bool loaded_area_data_ = false;
   std::set<std::string> malconfigured_areas_;
 
+  HotGameData hot_data_;
+
+  // The lists in the hot data can only be added in panel order, so they are
+  // collected here while the YAML is being parsed.
+  std::vector<std::vector<LingoColor>> panel_colors_;
+  std::vector<std::vector<int>> panel_required_doors_;
+
   GameData() {
-    YAML::Node lingo_config = YAML::LoadFile("assets/LL1.yaml");
-    YAML::Node areas_config = YAML::LoadFile("assets/areas.yaml");
-    YAML::Node pilgrimage_config = YAML::LoadFile("assets/pilgrimage.yaml");
-    YAML::Node ids_config = YAML::LoadFile("assets/ids.yaml");
-
-    auto init_color_id = [this, &ids_config](const std::string &color_name) {
-      if (ids_config["special_items"] &&
-          ids_config["special_items"][color_name]) {
+    std::optional<uint64_t> source_hash = HashSourceFiles();
+
+#ifdef LINGO_EMBEDDED_GAME_DATA
+    // The game data that was compiled in is used unless the files in assets/
+    // differ from the ones it was compiled from, so that it can still be
+    // modded. Its names are used in place rather than copied.
+    GameDataReader embedded_reader(GetEmbeddedGameData(), source_hash,
+                                   names_);
+    bool loaded = LoadImage(embedded_reader);
+    if (!loaded && !source_hash) {
+      TrackerLog("The compiled in game data is invalid");
+    }
+#else
+    bool loaded = false;
+#endif
+
+    if (!loaded && (!source_hash || !LoadCache(*source_hash))) {
+      LoadYaml();
+
+      if (source_hash) {
+        SaveCache(*source_hash);
+      }
+    }
+
+    ReportErrors();
+  }
+
+  void ReportErrors() {
+    for (const std::string &area : malconfigured_areas_) {
+      std::ostringstream errstr;
+      errstr << "Area data not found for: " << area;
+      TrackerLog(errstr.str());
+    }
+  }
+
+  bool LoadCache(uint64_t source_hash) {
+    GameDataReader reader(GetCachePath(), source_hash, names_);
+    return LoadImage(reader);
+  }
+
+  bool LoadImage(GameDataReader &reader) {
+    Transfer(reader);
+
+    if (!reader.ok() || !reader.AtEnd()) {
+      // The image may have been partly read before it turned out to be bad.
+      auto clear = [](auto &...values) { ((values = {}), ...); };
+      Transfer(clear);
+
+      return false;
+    }
+
+    IndexNames();
+    return true;
+  }
+
+  // The lookup tables by name aren't stored in the cache, as they can be
+  // rebuilt from the structs.
+  void IndexNames() {
+    for (int room_id = 0; room_id < rooms_.size(); room_id++) {
+      room_by_id_[rooms_[room_id].name] = room_id;
+    }
+
+    for (int door_id = 0; door_id < doors_.size(); door_id++) {
+      door_by_id_[{doors_[door_id].room, doors_[door_id].name}] = door_id;
+    }
+
+    for (const Panel &panel : panels_) {
+      panel_by_id_[{hot_data_.panel_rooms[panel.id], panel.name}] = panel.id;
+    }
+
+    for (const MapArea &map_area : map_areas_) {
+      area_by_id_[map_area.name] = map_area.id;
+    }
+  }
+
+  void SaveCache(uint64_t source_hash) {
+    GameDataWriter writer(source_hash);
+    Transfer(writer);
+
+    // The tracker still works without the cache, so it is only worth
+    // reporting if the directory could be written to but the cache couldn't.
+    if (writer.Save(GetCachePath()) == GameDataWriter::SaveResult::kFailed) {
+      TrackerLog("Could not write the game data cache");
+    }
+  }
+
+  // Everything that is stored in the cache. Anything only needed while the
+  // YAML is being parsed is left out.
+  template <typename Archive>
+  void Transfer(Archive &ar) {
+    ar(rooms_, doors_, panels_, map_areas_, location_count_,
+       door_definition_order_, room_by_painting_, achievement_panels_,
+       ap_id_by_color_, malconfigured_areas_, hot_data_);
+  }
+
+  void LoadYaml() {
+    YAML::Node lingo_config = YAML::LoadFile(LINGO_CONFIG_FILE);
+    YAML::Node areas_config = YAML::LoadFile(AREAS_CONFIG_FILE);
+    YAML::Node pilgrimage_config = YAML::LoadFile(PILGRIMAGE_CONFIG_FILE);
+    IdIndex ids(YAML::LoadFile(IDS_CONFIG_FILE));
+
+    auto init_color_id = [this, &ids](const std::string &color_name) {
+      if (std::optional<int> ap_id =
+              ids.Find(IdKind::kSpecialItem, color_name)) {
         std::string input_name = color_name;
         input_name[0] = std::tolower(input_name[0]);
-        ap_id_by_color_[GetColorForString(input_name)] =
-            ids_config["special_items"][color_name].as<int>();
+        ap_id_by_color_[GetColorForString(input_name)] = *ap_id;
       } else {
         std::ostringstream errmsg;
         errmsg << "Missing AP item ID for color " << color_name;
@@ -111,7 +358,7 @@ struct GameData {
             exit_obj.destination_room = room_id;
 
             if (entrance_it.second["door"]) {
-              std::string door_room = room_obj.name;
+              std::string door_room(room_obj.name);
               if (entrance_it.second["room"]) {
                 door_room = entrance_it.second["room"].as<std::string>();
               }
@@ -131,7 +378,7 @@ struct GameData {
               Exit exit_obj;
               exit_obj.destination_room = room_id;
 
-              std::string door_room = room_obj.name;
+              std::string door_room(room_obj.name);
               if (option["room"]) {
                 door_room = option["room"].as<std::string>();
               }
@@ -165,11 +412,11 @@ struct GameData {
 
           if (panel_it.second["colors"]) {
             if (panel_it.second["colors"].IsScalar()) {
-              panel_obj.colors.push_back(GetColorForString(
+              panel_colors_[panel_id].push_back(GetColorForString(
                   panel_it.second["colors"].as<std::string>()));
             } else {
               for (const auto &color_node : panel_it.second["colors"]) {
-                panel_obj.colors.push_back(
+                panel_colors_[panel_id].push_back(
                     GetColorForString(color_node.as<std::string>()));
               }
             }
@@ -189,23 +436,23 @@ struct GameData {
 
           if (panel_it.second["required_door"]) {
             if (panel_it.second["required_door"].IsMap()) {
-              std::string rd_room = room_obj.name;
+              std::string rd_room(room_obj.name);
               if (panel_it.second["required_door"]["room"]) {
                 rd_room =
                     panel_it.second["required_door"]["room"].as<std::string>();
               }
 
-              panel_obj.required_doors.push_back(AddOrGetDoor(
+              panel_required_doors_[panel_id].push_back(AddOrGetDoor(
                   rd_room,
                   panel_it.second["required_door"]["door"].as<std::string>()));
             } else {
               for (const auto &rr_node : panel_it.second["required_door"]) {
-                std::string rd_room = room_obj.name;
+                std::string rd_room(room_obj.name);
                 if (rr_node["room"]) {
                   rd_room = rr_node["room"].as<std::string>();
                 }
 
-                panel_obj.required_doors.push_back(
+                panel_required_doors_[panel_id].push_back(
                     AddOrGetDoor(rd_room, rr_node["door"].as<std::string>()));
               }
             }
@@ -213,7 +460,7 @@ struct GameData {
 
           if (panel_it.second["required_panel"]) {
             if (panel_it.second["required_panel"].IsMap()) {
-              std::string rp_room = room_obj.name;
+              std::string rp_room(room_obj.name);
               if (panel_it.second["required_panel"]["room"]) {
                 rp_room =
                     panel_it.second["required_panel"]["room"].as<std::string>();
@@ -224,7 +471,7 @@ struct GameData {
                                .as<std::string>()));
             } else {
               for (const auto &rp_node : panel_it.second["required_panel"]) {
-                std::string rp_room = room_obj.name;
+                std::string rp_room(room_obj.name);
                 if (rp_node["room"]) {
                   rp_room = rp_node["room"].as<std::string>();
                 }
@@ -241,8 +488,8 @@ struct GameData {
 
           if (panel_it.second["achievement"]) {
             panel_obj.achievement = true;
-            panel_obj.achievement_name =
-                panel_it.second["achievement"].as<std::string>();
+            panel_obj.achievement_name = names_.Intern(
+                panel_it.second["achievement"].as<std::string>());
 
             achievement_panels_.push_back(panel_id);
           }
@@ -256,10 +503,15 @@ struct GameData {
             panel_obj.non_counting = panel_it.second["non_counting"].as<bool>();
           }
 
-          if (ids_config["panels"] && ids_config["panels"][room_obj.name] &&
-              ids_config["panels"][room_obj.name][panel_obj.name]) {
-            panel_obj.ap_location_id =
-                ids_config["panels"][room_obj.name][panel_obj.name].as<int>();
+          if (panel_obj.name == "THE MASTER") {
+            panel_obj.special = SpecialPanel::kTheMaster;
+          } else if (panel_obj.name == "ANOTHER TRY") {
+            panel_obj.special = SpecialPanel::kAnotherTry;
+          }
+
+          if (std::optional<int> ap_id =
+                  ids.Find(IdKind::kPanel, room_obj.name, panel_obj.name)) {
+            panel_obj.ap_location_id = *ap_id;
           } else {
             std::ostringstream errmsg;
             errmsg << "Missing AP location ID for panel " << room_obj.name
@@ -298,28 +550,30 @@ struct GameData {
           }
 
           if (door_it.second["skip_item"]) {
-            door_obj.skip_item = door_it.second["skip_item"].as<bool>();
+            hot_data_.door_skip_item[door_id] =
+                door_it.second["skip_item"].as<bool>();
           }
 
           if (door_it.second["event"]) {
             door_obj.skip_location = door_it.second["event"].as<bool>();
-            door_obj.skip_item = door_it.second["event"].as<bool>();
+            hot_data_.door_skip_item[door_id] =
+                door_it.second["event"].as<bool>();
             door_obj.is_event = door_it.second["event"].as<bool>();
           }
 
           if (door_it.second["item_name"]) {
-            door_obj.item_name = door_it.second["item_name"].as<std::string>();
+            door_obj.item_name =
+                names_.Intern(door_it.second["item_name"].as<std::string>());
           } else if (!door_it.second["skip_item"] && !door_it.second["event"]) {
-            door_obj.item_name = room_obj.name + " - " + door_obj.name;
+            door_obj.item_name = names_.Intern(std::string(room_obj.name) +
+                                               " - " +
+                                               std::string(door_obj.name));
           }
 
           if (!door_it.second["skip_item"] && !door_it.second["event"]) {
-            if (ids_config["doors"] && ids_config["doors"][room_obj.name] &&
-                ids_config["doors"][room_obj.name][door_obj.name] &&
-                ids_config["doors"][room_obj.name][door_obj.name]["item"]) {
-              door_obj.ap_item_id =
-                  ids_config["doors"][room_obj.name][door_obj.name]["item"]
-                      .as<int>();
+            if (std::optional<int> ap_id = ids.Find(
+                    IdKind::kDoorItem, room_obj.name, door_obj.name)) {
+              door_obj.ap_item_id = *ap_id;
             } else {
               std::ostringstream errmsg;
               errmsg << "Missing AP item ID for door " << room_obj.name << " - "
@@ -329,12 +583,12 @@ struct GameData {
           }
 
           if (door_it.second["group"]) {
-            door_obj.group_name = door_it.second["group"].as<std::string>();
+            door_obj.group_name =
+                names_.Intern(door_it.second["group"].as<std::string>());
 
-            if (ids_config["door_groups"] &&
-                ids_config["door_groups"][door_obj.group_name]) {
-              door_obj.group_ap_item_id =
-                  ids_config["door_groups"][door_obj.group_name].as<int>();
+            if (std::optional<int> ap_id =
+                    ids.Find(IdKind::kDoorGroup, door_obj.group_name)) {
+              door_obj.group_ap_item_id = *ap_id;
             } else {
               std::ostringstream errmsg;
               errmsg << "Missing AP item ID for door group "
@@ -344,8 +598,8 @@ struct GameData {
           }
 
           if (door_it.second["location_name"]) {
-            door_obj.location_name =
-                door_it.second["location_name"].as<std::string>();
+            door_obj.location_name = names_.Intern(
+                door_it.second["location_name"].as<std::string>());
           } else if (!door_it.second["skip_location"] &&
                      !door_it.second["event"]) {
             if (has_external_panels) {
@@ -359,16 +613,14 @@ struct GameData {
             }
 
             door_obj.location_name =
-                room_obj.name + " - " + hatkirby::implode(panel_names, ", ");
+                names_.Intern(std::string(room_obj.name) + " - " +
+                              hatkirby::implode(panel_names, ", "));
           }
 
           if (!door_it.second["skip_location"] && !door_it.second["event"]) {
-            if (ids_config["doors"] && ids_config["doors"][room_obj.name] &&
-                ids_config["doors"][room_obj.name][door_obj.name] &&
-                ids_config["doors"][room_obj.name][door_obj.name]["location"]) {
-              door_obj.ap_location_id =
-                  ids_config["doors"][room_obj.name][door_obj.name]["location"]
-                      .as<int>();
+            if (std::optional<int> ap_id = ids.Find(
+                    IdKind::kDoorLocation, room_obj.name, door_obj.name)) {
+              door_obj.ap_location_id = *ap_id;
             } else {
               std::ostringstream errmsg;
               errmsg << "Missing AP location ID for door " << room_obj.name
@@ -386,7 +638,8 @@ struct GameData {
 
       if (room_it.second["paintings"]) {
         for (const auto &painting : room_it.second["paintings"]) {
-          std::string painting_id = painting["id"].as<std::string>();
+          std::string_view painting_id =
+              names_.Intern(painting["id"].as<std::string>());
           room_by_painting_[painting_id] = room_id;
 
           if (!painting["exit_only"] || !painting["exit_only"].as<bool>()) {
@@ -394,7 +647,7 @@ struct GameData {
             painting_exit.id = painting_id;
 
             if (painting["required_door"]) {
-              std::string rd_room = room_obj.name;
+              std::string rd_room(room_obj.name);
               if (painting["required_door"]["room"]) {
                 rd_room = painting["required_door"]["room"].as<std::string>();
               }
@@ -414,10 +667,9 @@ struct GameData {
               progression_it.first.as<std::string>();
 
           int progressive_item_id = -1;
-          if (ids_config["progression"] &&
-              ids_config["progression"][progressive_item_name]) {
-            progressive_item_id =
-                ids_config["progression"][progressive_item_name].as<int>();
+          if (std::optional<int> ap_id =
+                  ids.Find(IdKind::kProgression, progressive_item_name)) {
+            progressive_item_id = *ap_id;
           } else {
             std::ostringstream errmsg;
             errmsg << "Missing AP item ID for progressive item "
@@ -437,7 +689,7 @@ struct GameData {
             }
 
             doors_[door_id].progressives.push_back(
-                {.item_name = progressive_item_name,
+                {.item_name = names_.Intern(progressive_item_name),
                  .ap_item_id = progressive_item_id,
                  .quantity = index});
             index++;
@@ -464,11 +716,11 @@ struct GameData {
     loaded_area_data_ = true;
 
     // Only locations for the panels are kept here.
-    std::map<std::string, std::tuple<int, int>> locations_by_name;
+    std::map<std::string_view, int> locations_by_name;
 
     for (const Panel &panel : panels_) {
-      int room_id = panel.room;
-      std::string room_name = rooms_[room_id].name;
+      int room_id = hot_data_.panel_rooms[panel.id];
+      std::string room_name(rooms_[room_id].name);
 
       std::string area_name = room_name;
       if (fold_areas.count(room_name)) {
@@ -484,18 +736,14 @@ struct GameData {
         }
       }
 
-      int area_id = AddOrGetArea(area_name);
-      MapArea &map_area = map_areas_[area_id];
+      std::string_view ap_location_name =
+          names_.Intern(room_name + " - " + std::string(panel.name));
       // room field should be the original room ID
-      map_area.locations.push_back(
-          {.name = panel.name,
-           .ap_location_name = room_name + " - " + panel.name,
-           .ap_location_id = panel.ap_location_id,
-           .room = panel.room,
-           .panels = {panel.id},
-           .classification = classification});
-      locations_by_name[map_area.locations.back().ap_location_name] = {
-          area_id, map_area.locations.size() - 1};
+      int location_id = AddLocation(
+          AddOrGetArea(area_name),
+          {.name = panel.name, .ap_location_name = ap_location_name},
+          panel.ap_location_id, room_id, {panel.id}, classification);
+      locations_by_name[ap_location_name] = location_id;
     }
 
     for (int door_id : door_definition_order_) {
@@ -507,17 +755,17 @@ struct GameData {
           classification |= kLOCATION_REDUCED;
         }
 
-        if (locations_by_name.count(door.location_name)) {
-          auto [area_id, section_id] = locations_by_name[door.location_name];
-          map_areas_[area_id].locations[section_id].classification |=
+        auto location_it = locations_by_name.find(door.location_name);
+        if (location_it != locations_by_name.end()) {
+          hot_data_.location_classifications[location_it->second] |=
               classification;
         } else {
           int room_id = door.room;
-          std::string area_name = rooms_[room_id].name;
+          std::string area_name(rooms_[room_id].name);
           std::string section_name;
 
           size_t divider_pos = door.location_name.find(" - ");
-          if (divider_pos == std::string::npos) {
+          if (divider_pos == std::string_view::npos) {
             section_name = door.location_name;
           } else {
             area_name = door.location_name.substr(0, divider_pos);
@@ -529,22 +777,20 @@ struct GameData {
             area_name = map_areas_[fold_area_id].name;
           }
 
-          int area_id = AddOrGetArea(area_name);
-          MapArea &map_area = map_areas_[area_id];
           // room field should be the original room ID
-          map_area.locations.push_back({.name = section_name,
-                                        .ap_location_name = door.location_name,
-                                        .ap_location_id = door.ap_location_id,
-                                        .room = door.room,
-                                        .panels = door.panels,
-                                        .classification = classification});
+          AddLocation(AddOrGetArea(area_name),
+                      {.name = names_.Intern(section_name),
+                       .ap_location_name = door.location_name},
+                      door.ap_location_id, door.room, door.panels,
+                      classification);
         }
       }
     }
 
     for (MapArea &map_area : map_areas_) {
       for (const Location &location : map_area.locations) {
-        map_area.classification |= location.classification;
+        map_area.classification |=
+            hot_data_.location_classifications[location.id];
       }
     }
 
@@ -555,7 +801,7 @@ struct GameData {
     fake_pilgrim_panel_obj.non_counting = true;
 
     for (const auto &config_node : pilgrimage_config) {
-      fake_pilgrim_panel_obj.required_doors.push_back(
+      panel_required_doors_[fake_pilgrim_panel_id].push_back(
           AddOrGetDoor(config_node["room"].as<std::string>(),
                        config_node["door"].as<std::string>()));
     }
@@ -565,8 +811,8 @@ struct GameData {
     Door &fake_pilgrim_door_obj = doors_[fake_pilgrim_door_id];
     fake_pilgrim_door_obj.panels.push_back(fake_pilgrim_panel_id);
     fake_pilgrim_door_obj.skip_location = true;
-    fake_pilgrim_door_obj.skip_item = true;
     fake_pilgrim_door_obj.is_event = true;
+    hot_data_.door_skip_item[fake_pilgrim_door_id] = true;
 
     int starting_room_id = AddOrGetRoom("Starting Room");
     Room &starting_room_obj = rooms_[starting_room_id];
@@ -575,59 +821,97 @@ struct GameData {
         Exit{.destination_room = AddOrGetRoom("Pilgrim Antechamber"),
              .door = fake_pilgrim_door_id});
 
-    // Report errors.
-    for (const std::string &area : malconfigured_areas_) {
-      std::ostringstream errstr;
-      errstr << "Area data not found for: " << area;
-      TrackerLog(errstr.str());
+    for (int panel_id = 0; panel_id < panels_.size(); panel_id++) {
+      hot_data_.panel_colors.Add(panel_colors_[panel_id]);
+      hot_data_.panel_required_doors.Add(panel_required_doors_[panel_id]);
+    }
+    panel_colors_.clear();
+    panel_required_doors_.clear();
+
+    for (const Door &door : doors_) {
+      hot_data_.door_in_group.push_back(!door.group_name.empty());
     }
   }
 
-  int AddOrGetRoom(std::string room) {
-    if (!room_by_id_.count(room)) {
-      room_by_id_[room] = rooms_.size();
-      rooms_.push_back({.name = room});
+  int AddOrGetRoom(std::string_view room) {
+    auto it = room_by_id_.find(room);
+    if (it != room_by_id_.end()) {
+      return it->second;
     }
 
-    return room_by_id_[room];
+    int room_id = rooms_.size();
+    room_by_id_[names_.Intern(room)] = room_id;
+    rooms_.push_back({.name = names_.Intern(room)});
+
+    return room_id;
   }
 
-  int AddOrGetDoor(std::string room, std::string door) {
-    std::string full_name = room + " - " + door;
+  int AddOrGetDoor(std::string_view room, std::string_view door) {
+    int room_id = AddOrGetRoom(room);
 
-    if (!door_by_id_.count(full_name)) {
-      door_by_id_[full_name] = doors_.size();
-      doors_.push_back({.room = AddOrGetRoom(room), .name = door});
+    auto it = door_by_id_.find({room_id, door});
+    if (it != door_by_id_.end()) {
+      return it->second;
     }
 
-    return door_by_id_[full_name];
+    int door_id = doors_.size();
+    door_by_id_[{room_id, names_.Intern(door)}] = door_id;
+    doors_.push_back({.room = room_id, .name = names_.Intern(door)});
+    hot_data_.door_skip_item.push_back(false);
+
+    return door_id;
   }
 
-  int AddOrGetPanel(std::string room, std::string panel) {
-    std::string full_name = room + " - " + panel;
+  int AddOrGetPanel(std::string_view room, std::string_view panel) {
+    int room_id = AddOrGetRoom(room);
 
-    if (!panel_by_id_.count(full_name)) {
-      int panel_id = panels_.size();
-      panel_by_id_[full_name] = panel_id;
-      panels_.push_back(
-          {.id = panel_id, .room = AddOrGetRoom(room), .name = panel});
+    auto it = panel_by_id_.find({room_id, panel});
+    if (it != panel_by_id_.end()) {
+      return it->second;
     }
 
-    return panel_by_id_[full_name];
+    int panel_id = panels_.size();
+    panel_by_id_[{room_id, names_.Intern(panel)}] = panel_id;
+    panels_.push_back({.id = panel_id, .name = names_.Intern(panel)});
+    hot_data_.panel_rooms.push_back(room_id);
+    panel_colors_.emplace_back();
+    panel_required_doors_.emplace_back();
+
+    return panel_id;
   }
 
-  int AddOrGetArea(std::string area) {
-    if (!area_by_id_.count(area)) {
-      if (loaded_area_data_) {
-        malconfigured_areas_.insert(area);
-      }
+  // Numbers the location, and stores the fields that the solver reads in the
+  // hot data. Returns the location's ID.
+  int AddLocation(int area_id, Location location, int ap_location_id, int room,
+                  const std::vector<int> &panels, int classification) {
+    int location_id = location_count_++;
+    location.id = location_id;
+    map_areas_[area_id].locations.push_back(location);
+
+    hot_data_.location_rooms.push_back(room);
+    hot_data_.location_ap_ids.push_back(ap_location_id);
+    hot_data_.location_classifications.push_back(classification);
+    hot_data_.location_panels.Add(panels);
+
+    return location_id;
+  }
 
-      int area_id = map_areas_.size();
-      area_by_id_[area] = area_id;
-      map_areas_.push_back({.id = area_id, .name = area});
+  int AddOrGetArea(std::string_view area) {
+    auto it = area_by_id_.find(area);
+    if (it != area_by_id_.end()) {
+      return it->second;
     }
 
-    return area_by_id_[area];
+    if (loaded_area_data_) {
+      malconfigured_areas_.insert(std::string(area));
+    }
+
+    int area_id = map_areas_.size();
+    std::string_view name = names_.Intern(area);
+    area_by_id_[name] = area_id;
+    map_areas_.push_back({.id = area_id, .name = name});
+
+    return area_id;
   }
 };
 
@@ -642,21 +926,27 @@ const std::vector<MapArea> &GD_GetMapAreas() { return GetState().map_areas_; }
 
 const MapArea &GD_GetMapArea(int id) { return GetState().map_areas_.at(id); }
 
-int GD_GetRoomByName(const std::string &name) {
+int GD_GetLocationCount() { return GetState().location_count_; }
+
+int GD_GetRoomByName(std::string_view name) {
   return GetState().room_by_id_.at(name);
 }
 
+const std::vector<Room> &GD_GetRooms() { return GetState().rooms_; }
+
 const Room &GD_GetRoom(int room_id) { return GetState().rooms_.at(room_id); }
 
 const std::vector<Door> &GD_GetDoors() { return GetState().doors_; }
 
 const Door &GD_GetDoor(int door_id) { return GetState().doors_.at(door_id); }
 
+const std::vector<Panel> &GD_GetPanels() { return GetState().panels_; }
+
 const Panel &GD_GetPanel(int panel_id) {
   return GetState().panels_.at(panel_id);
 }
 
-int GD_GetRoomForPainting(const std::string &painting_id) {
+int GD_GetRoomForPainting(std::string_view painting_id) {
   return GetState().room_by_painting_.at(painting_id);
 }
 
@@ -664,6 +954,17 @@ const std::vector<int> &GD_GetAchievementPanels() {
   return GetState().achievement_panels_;
 }
 
-int GD_GetItemIdForColor(LingoColor color) {
-  return GetState().ap_id_by_color_.at(color);
+int GD_FindItemIdForColor(LingoColor color) {
+  const std::map<LingoColor, int> &ap_id_by_color = GetState().ap_id_by_color_;
+  auto it = ap_id_by_color.find(color);
+  return it == ap_id_by_color.end() ? -1 : it->second;
+}
+
+const HotGameData &GD_GetHotData() { return GetState().hot_data_; }
+
+std::string GD_SerializeGameData() {
+  GameDataWriter writer(HashSourceFiles().value_or(0));
+  GetState().Transfer(writer);
+
+  return writer.image();
 }
@@ -1,9 +1,12 @@
 #ifndef GAME_DATA_H_9C42AC51
 #define GAME_DATA_H_9C42AC51
 
+#include <cstdint>
 #include <map>
 #include <optional>
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
 enum class LingoColor {
@@ -19,40 +22,48 @@ enum class LingoColor {
   kGray
 };
 
+// Panels whose requirements are not described by the game data, and have to
+// be handled by the tracker specifically.
+enum class SpecialPanel { kNone, kTheMaster, kAnotherTry };
+
 constexpr int kLOCATION_NORMAL = 1;
 constexpr int kLOCATION_REDUCED = 2;
 constexpr int kLOCATION_INSANITY = 4;
 
+// Names that are string_views point into storage that belongs to the game
+// data, and stay valid for as long as the program runs. Each distinct name is
+// only stored once.
+//
+// The fields that the reachability solver reads are not in these structs, but
+// in HotGameData below.
+
 struct Panel {
   int id;
-  int room;
-  std::string name;
-  std::vector<LingoColor> colors;
+  std::string_view name;
   std::vector<int> required_rooms;
-  std::vector<int> required_doors;
   std::vector<int> required_panels;
   bool check = false;
   bool exclude_reduce = false;
   bool achievement = false;
-  std::string achievement_name;
+  std::string_view achievement_name;
   bool non_counting = false;
+  SpecialPanel special = SpecialPanel::kNone;
   int ap_location_id = -1;
 };
 
 struct ProgressiveRequirement {
-  std::string item_name;
+  std::string_view item_name;
   int ap_item_id = -1;
   int quantity = 0;
 };
 
 struct Door {
   int room;
-  std::string name;
-  std::string location_name;
-  std::string item_name;
-  std::string group_name;
+  std::string_view name;
+  std::string_view location_name;
+  std::string_view item_name;
+  std::string_view group_name;
   bool skip_location = false;
-  bool skip_item = false;
   bool is_event = false;
   std::vector<int> panels;
   bool exclude_reduce = true;
@@ -69,44 +80,95 @@ struct Exit {
 };
 
 struct PaintingExit {
-  std::string id;
+  std::string_view id;
   std::optional<int> door;
 };
 
 struct Room {
-  std::string name;
+  std::string_view name;
   std::vector<Exit> exits;
   std::vector<PaintingExit> paintings;
   std::vector<int> panels;
 };
 
 struct Location {
-  std::string name;
-  std::string ap_location_name;
-  int ap_location_id = -1;
-  int room;
-  std::vector<int> panels;
-  int classification = 0;
+  int id = -1;
+  std::string_view name;
+  std::string_view ap_location_name;
 };
 
 struct MapArea {
   int id;
-  std::string name;
+  std::string_view name;
   std::vector<Location> locations;
   int map_x;
   int map_y;
   int classification = 0;
 };
 
+// A list for each index, stored end to end.
+template <typename T>
+class FlatLists {
+ public:
+  void Add(const std::vector<T>& list) {
+    values_.insert(values_.end(), list.begin(), list.end());
+    offsets_.push_back(values_.size());
+  }
+
+  std::span<const T> operator[](int index) const {
+    return {values_.data() + offsets_[index],
+            values_.data() + offsets_[index + 1]};
+  }
+
+  template <typename Archive>
+  void Transfer(Archive& ar) {
+    ar(offsets_, values_);
+  }
+
+ private:
+  std::vector<int> offsets_ = {0};
+  std::vector<T> values_;
+};
+
+// The fields of panels, doors and locations that the reachability solver
+// reads every time it runs, as parallel arrays. Scanning these doesn't drag
+// the names and other fields that are only displayed through the cache, like
+// walking the structs above would. This is the only place they are stored.
+struct HotGameData {
+  // Indexed by panel ID.
+  std::vector<int> panel_rooms;
+  FlatLists<int> panel_required_doors;
+  FlatLists<LingoColor> panel_colors;
+
+  // Indexed by door ID. door_in_group is whether the door has a group name.
+  std::vector<uint8_t> door_skip_item;
+  std::vector<uint8_t> door_in_group;
+
+  // Indexed by Location::id.
+  std::vector<int> location_rooms;
+  std::vector<int> location_ap_ids;
+  std::vector<int> location_classifications;
+  FlatLists<int> location_panels;
+};
+
 const std::vector<MapArea>& GD_GetMapAreas();
 const MapArea& GD_GetMapArea(int id);
-int GD_GetRoomByName(const std::string& name);
+int GD_GetLocationCount();
+int GD_GetRoomByName(std::string_view name);
+const std::vector<Room>& GD_GetRooms();
 const Room& GD_GetRoom(int room_id);
 const std::vector<Door>& GD_GetDoors();
 const Door& GD_GetDoor(int door_id);
+const std::vector<Panel>& GD_GetPanels();
 const Panel& GD_GetPanel(int panel_id);
-int GD_GetRoomForPainting(const std::string& painting_id);
+int GD_GetRoomForPainting(std::string_view painting_id);
 const std::vector<int>& GD_GetAchievementPanels();
-int GD_GetItemIdForColor(LingoColor color);
+// Returns -1 if the game data has no item for the color.
+int GD_FindItemIdForColor(LingoColor color);
+const HotGameData& GD_GetHotData();
+
+// An image of the game data that is currently loaded, in the format of
+// game_data_cache.h. Used to compile the game data into the tracker.
+std::string GD_SerializeGameData();
 
 #endif /* end of include guard: GAME_DATA_H_9C42AC51 */
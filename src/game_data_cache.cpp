@@ -0,0 +1,163 @@
+#include "game_data_cache.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <system_error>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__APPLE__)
+#include <mach-o/dyld.h>
+#endif
+
+namespace {
+
+constexpr char kCacheMagic[4] = {'L', 'G', 'D', 'C'};
+
+constexpr uint64_t kFnvOffsetBasis = 14695981039346656037ULL;
+constexpr uint64_t kFnvPrime = 1099511628211ULL;
+
+std::optional<std::string> ReadWholeFile(const std::filesystem::path& path) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    return std::nullopt;
+  }
+
+  return std::string(std::istreambuf_iterator<char>(file),
+                     std::istreambuf_iterator<char>());
+}
+
+}  // namespace
+
+std::optional<uint64_t> HashGameDataFiles(
+    const std::vector<std::string>& paths) {
+  uint64_t hash = kFnvOffsetBasis;
+
+  for (const std::string& path : paths) {
+    std::optional<std::string> contents = ReadWholeFile(path);
+    if (!contents) {
+      return std::nullopt;
+    }
+
+    // The length goes in as well, so that moving bytes from the end of one
+    // file to the start of the next changes the hash.
+    uint64_t length = contents->size();
+    contents->append(reinterpret_cast<const char*>(&length), sizeof(length));
+
+    for (char ch : *contents) {
+      hash ^= static_cast<uint8_t>(ch);
+      hash *= kFnvPrime;
+    }
+  }
+
+  return hash;
+}
+
+std::filesystem::path GetExecutableDirectory() {
+#ifdef _WIN32
+  std::wstring buffer(MAX_PATH, L'\0');
+  for (;;) {
+    DWORD length = GetModuleFileNameW(nullptr, buffer.data(),
+                                      static_cast<DWORD>(buffer.size()));
+    if (length == 0) {
+      return {};
+    } else if (length < buffer.size()) {
+      buffer.resize(length);
+      return std::filesystem::path(buffer).parent_path();
+    }
+
+    // The path was cut off, so it is tried again with more room.
+    buffer.resize(buffer.size() * 2);
+  }
+#elif defined(__APPLE__)
+  uint32_t size = 0;
+  _NSGetExecutablePath(nullptr, &size);
+  std::string buffer(size, '\0');
+  if (_NSGetExecutablePath(buffer.data(), &size) != 0) {
+    return {};
+  }
+
+  buffer.resize(std::strlen(buffer.c_str()));
+  return std::filesystem::path(buffer).parent_path();
+#else
+  std::error_code error;
+  std::filesystem::path path =
+      std::filesystem::read_symlink("/proc/self/exe", error);
+  return error ? std::filesystem::path() : path.parent_path();
+#endif
+}
+
+GameDataWriter::GameDataWriter(uint64_t source_hash) {
+  WriteBytes(kCacheMagic, sizeof(kCacheMagic));
+
+  uint32_t version = kGameDataCacheVersion;
+  WriteBytes(&version, sizeof(version));
+  WriteBytes(&source_hash, sizeof(source_hash));
+}
+
+GameDataWriter::SaveResult GameDataWriter::Save(
+    const std::filesystem::path& path) const {
+  std::filesystem::path temp_path = path;
+  temp_path += ".tmp";
+
+  {
+    std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+      return SaveResult::kNotWritable;
+    }
+
+    if (!file.write(buffer_.data(), buffer_.size())) {
+      return SaveResult::kFailed;
+    }
+  }
+
+  std::error_code error;
+  std::filesystem::rename(temp_path, path, error);
+  if (error) {
+    std::filesystem::remove(temp_path, error);
+    return SaveResult::kFailed;
+  }
+
+  return SaveResult::kSaved;
+}
+
+GameDataReader::GameDataReader(const std::filesystem::path& path,
+                               uint64_t source_hash, StringArena& names)
+    : names_(names) {
+  std::optional<std::string> contents = ReadWholeFile(path);
+  if (!contents) {
+    return;
+  }
+
+  storage_ = std::move(*contents);
+  buffer_ = storage_;
+  ReadHeader(source_hash);
+}
+
+GameDataReader::GameDataReader(std::string_view image,
+                               std::optional<uint64_t> source_hash,
+                               StringArena& names)
+    : names_(names), buffer_(image) {
+  ReadHeader(source_hash);
+}
+
+void GameDataReader::ReadHeader(std::optional<uint64_t> source_hash) {
+  ok_ = true;
+
+  char magic[sizeof(kCacheMagic)] = {};
+  uint32_t version = 0;
+  uint64_t hash = 0;
+  ReadBytes(magic, sizeof(magic));
+  ReadBytes(&version, sizeof(version));
+  ReadBytes(&hash, sizeof(hash));
+
+  if (std::memcmp(magic, kCacheMagic, sizeof(magic)) != 0 ||
+      version != kGameDataCacheVersion ||
+      (source_hash && hash != *source_hash)) {
+    ok_ = false;
+  }
+}
@@ -0,0 +1,374 @@
+#ifndef GAME_DATA_CACHE_H_5B81E3D6
+#define GAME_DATA_CACHE_H_5B81E3D6
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "game_data.h"
+#include "string_arena.h"
+
+// A binary image of the game data, so that the YAML files only have to be
+// parsed again when they change. The image starts with a format version and a
+// hash of the files it was built from, and is thrown away if either of them
+// doesn't match. Values are stored in the byte order of the machine that wrote
+// them, so an image can only be read on a machine with the same byte order.
+//
+// Both archives take their values through operator(), so that the list of
+// fields only has to be written down once, in TransferFields.
+
+// Has to be bumped whenever anything that is stored in the image changes.
+constexpr uint32_t kGameDataCacheVersion = 3;
+
+// FNV-1a over the contents of the files, in order. Returns nothing if any of
+// them can't be read.
+std::optional<uint64_t> HashGameDataFiles(
+    const std::vector<std::string>& paths);
+
+// The directory that the running executable is in. The cache is kept there,
+// because installed builds are often run from a read-only working directory.
+// Empty, which stands for the working directory, if it can't be found.
+std::filesystem::path GetExecutableDirectory();
+
+template <typename Archive>
+void TransferFields(Archive& ar, Panel& panel);
+template <typename Archive>
+void TransferFields(Archive& ar, ProgressiveRequirement& progressive);
+template <typename Archive>
+void TransferFields(Archive& ar, Door& door);
+template <typename Archive>
+void TransferFields(Archive& ar, Exit& room_exit);
+template <typename Archive>
+void TransferFields(Archive& ar, PaintingExit& painting_exit);
+template <typename Archive>
+void TransferFields(Archive& ar, Room& room);
+template <typename Archive>
+void TransferFields(Archive& ar, Location& location);
+template <typename Archive>
+void TransferFields(Archive& ar, MapArea& map_area);
+template <typename Archive, typename T>
+void TransferFields(Archive& ar, FlatLists<T>& lists);
+template <typename Archive>
+void TransferFields(Archive& ar, HotGameData& hot_data);
+
+class GameDataWriter {
+ public:
+  explicit GameDataWriter(uint64_t source_hash);
+
+  template <typename... Ts>
+  void operator()(Ts&... values) {
+    (Write(values), ...);
+  }
+
+  enum class SaveResult { kSaved, kNotWritable, kFailed };
+
+  // Writes the image to a temporary file first, so that a partly written
+  // image is never picked up. kNotWritable means that the temporary file
+  // couldn't even be created, e.g. because the directory is read-only.
+  SaveResult Save(const std::filesystem::path& path) const;
+
+  const std::string& image() const { return buffer_; }
+
+ private:
+  void WriteBytes(const void* data, size_t size) {
+    buffer_.append(static_cast<const char*>(data), size);
+  }
+
+  template <typename T>
+  void Write(T& value) {
+    if constexpr (std::is_enum_v<T>) {
+      int32_t underlying = static_cast<int32_t>(value);
+      WriteBytes(&underlying, sizeof(underlying));
+    } else if constexpr (std::is_same_v<T, bool>) {
+      uint8_t byte = value ? 1 : 0;
+      WriteBytes(&byte, sizeof(byte));
+    } else if constexpr (std::is_arithmetic_v<T>) {
+      WriteBytes(&value, sizeof(value));
+    } else {
+      TransferFields(*this, value);
+    }
+  }
+
+  void Write(std::string& value) {
+    std::string_view view = value;
+    Write(view);
+  }
+
+  void Write(std::string_view& value) {
+    uint32_t size = value.size();
+    WriteBytes(&size, sizeof(size));
+    WriteBytes(value.data(), value.size());
+  }
+
+  template <typename T>
+  void Write(std::optional<T>& value) {
+    bool has_value = value.has_value();
+    Write(has_value);
+    if (has_value) {
+      Write(*value);
+    }
+  }
+
+  template <typename T>
+  void Write(std::vector<T>& values) {
+    uint32_t size = values.size();
+    WriteBytes(&size, sizeof(size));
+    for (T& value : values) {
+      Write(value);
+    }
+  }
+
+  template <typename K, typename V>
+  void Write(std::map<K, V>& values) {
+    WriteMap(values);
+  }
+
+  template <typename K, typename V>
+  void Write(std::unordered_map<K, V>& values) {
+    WriteMap(values);
+  }
+
+  template <typename Map>
+  void WriteMap(Map& values) {
+    uint32_t size = values.size();
+    WriteBytes(&size, sizeof(size));
+    for (auto& [key, value] : values) {
+      typename Map::key_type key_copy = key;
+      Write(key_copy);
+      Write(value);
+    }
+  }
+
+  template <typename T>
+  void Write(std::set<T>& values) {
+    uint32_t size = values.size();
+    WriteBytes(&size, sizeof(size));
+    for (T value : values) {
+      Write(value);
+    }
+  }
+
+  std::string buffer_;
+};
+
+class GameDataReader {
+ public:
+  // Loads the image, and checks that it was built from the same files by the
+  // same version of the tracker. If not, ok() will be false. Strings that are
+  // read into views are interned in the arena.
+  GameDataReader(const std::filesystem::path& path, uint64_t source_hash,
+                 StringArena& names);
+
+  // Reads an image that is already in memory, which has to outlive the arena,
+  // as strings read into views point into the image instead of being copied.
+  // Any source hash is accepted if none is given.
+  GameDataReader(std::string_view image, std::optional<uint64_t> source_hash,
+                 StringArena& names);
+
+  GameDataReader(const GameDataReader&) = delete;
+  GameDataReader& operator=(const GameDataReader&) = delete;
+
+  template <typename... Ts>
+  void operator()(Ts&... values) {
+    (Read(values), ...);
+  }
+
+  // False if the image was missing, stale, or ran out before everything was
+  // read. Once false, nothing else is read.
+  bool ok() const { return ok_; }
+
+  // Whether everything in the image has been read.
+  bool AtEnd() const { return position_ == buffer_.size(); }
+
+ private:
+  bool ReadBytes(void* data, size_t size) {
+    if (!ok_ || buffer_.size() - position_ < size) {
+      ok_ = false;
+      return false;
+    }
+
+    std::memcpy(data, buffer_.data() + position_, size);
+    position_ += size;
+    return true;
+  }
+
+  // A count that can't possibly fit in the rest of the image means that it is
+  // corrupted, and it shouldn't be used to reserve memory.
+  bool ReadSize(uint32_t& size) {
+    if (!ReadBytes(&size, sizeof(size)) ||
+        size > buffer_.size() - position_) {
+      ok_ = false;
+      return false;
+    }
+
+    return true;
+  }
+
+  template <typename T>
+  void Read(T& value) {
+    if constexpr (std::is_enum_v<T>) {
+      int32_t underlying = 0;
+      ReadBytes(&underlying, sizeof(underlying));
+      value = static_cast<T>(underlying);
+    } else if constexpr (std::is_same_v<T, bool>) {
+      uint8_t byte = 0;
+      ReadBytes(&byte, sizeof(byte));
+      value = byte != 0;
+    } else if constexpr (std::is_arithmetic_v<T>) {
+      ReadBytes(&value, sizeof(value));
+    } else {
+      TransferFields(*this, value);
+    }
+  }
+
+  void Read(std::string& value) {
+    uint32_t size = 0;
+    if (ReadSize(size)) {
+      value.assign(buffer_.data() + position_, size);
+      position_ += size;
+    }
+  }
+
+  void Read(std::string_view& value) {
+    uint32_t size = 0;
+    if (ReadSize(size)) {
+      std::string_view str = buffer_.substr(position_, size);
+      value = storage_.empty() ? names_.Adopt(str) : names_.Intern(str);
+      position_ += size;
+    }
+  }
+
+  template <typename T>
+  void Read(std::optional<T>& value) {
+    bool has_value = false;
+    Read(has_value);
+    if (has_value) {
+      Read(value.emplace());
+    } else {
+      value.reset();
+    }
+  }
+
+  template <typename T>
+  void Read(std::vector<T>& values) {
+    uint32_t size = 0;
+    if (ReadSize(size)) {
+      values.resize(size);
+      for (T& value : values) {
+        Read(value);
+      }
+    }
+  }
+
+  template <typename K, typename V>
+  void Read(std::map<K, V>& values) {
+    ReadMap(values);
+  }
+
+  template <typename K, typename V>
+  void Read(std::unordered_map<K, V>& values) {
+    ReadMap(values);
+  }
+
+  template <typename Map>
+  void ReadMap(Map& values) {
+    uint32_t size = 0;
+    if (ReadSize(size)) {
+      for (uint32_t i = 0; i < size && ok_; i++) {
+        typename Map::key_type key;
+        Read(key);
+        Read(values[key]);
+      }
+    }
+  }
+
+  template <typename T>
+  void Read(std::set<T>& values) {
+    uint32_t size = 0;
+    if (ReadSize(size)) {
+      for (uint32_t i = 0; i < size && ok_; i++) {
+        T value;
+        Read(value);
+        values.insert(std::move(value));
+      }
+    }
+  }
+
+  void ReadHeader(std::optional<uint64_t> source_hash);
+
+  StringArena& names_;
+  std::string storage_;
+  std::string_view buffer_;
+  size_t position_ = 0;
+  bool ok_ = false;
+};
+
+template <typename Archive>
+void TransferFields(Archive& ar, Panel& panel) {
+  ar(panel.id, panel.name, panel.required_rooms, panel.required_panels,
+     panel.check, panel.exclude_reduce, panel.achievement,
+     panel.achievement_name, panel.non_counting, panel.special,
+     panel.ap_location_id);
+}
+
+template <typename Archive>
+void TransferFields(Archive& ar, ProgressiveRequirement& progressive) {
+  ar(progressive.item_name, progressive.ap_item_id, progressive.quantity);
+}
+
+template <typename Archive>
+void TransferFields(Archive& ar, Door& door) {
+  ar(door.room, door.name, door.location_name, door.item_name,
+     door.group_name, door.skip_location, door.is_event, door.panels,
+     door.exclude_reduce, door.progressives, door.ap_item_id,
+     door.group_ap_item_id, door.ap_location_id);
+}
+
+template <typename Archive>
+void TransferFields(Archive& ar, Exit& room_exit) {
+  ar(room_exit.destination_room, room_exit.door, room_exit.painting);
+}
+
+template <typename Archive>
+void TransferFields(Archive& ar, PaintingExit& painting_exit) {
+  ar(painting_exit.id, painting_exit.door);
+}
+
+template <typename Archive>
+void TransferFields(Archive& ar, Room& room) {
+  ar(room.name, room.exits, room.paintings, room.panels);
+}
+
+template <typename Archive>
+void TransferFields(Archive& ar, Location& location) {
+  ar(location.id, location.name, location.ap_location_name);
+}
+
+template <typename Archive>
+void TransferFields(Archive& ar, MapArea& map_area) {
+  ar(map_area.id, map_area.name, map_area.locations, map_area.map_x,
+     map_area.map_y, map_area.classification);
+}
+
+template <typename Archive, typename T>
+void TransferFields(Archive& ar, FlatLists<T>& lists) {
+  lists.Transfer(ar);
+}
+
+template <typename Archive>
+void TransferFields(Archive& ar, HotGameData& hot_data) {
+  ar(hot_data.panel_rooms, hot_data.panel_required_doors,
+     hot_data.panel_colors, hot_data.door_skip_item, hot_data.door_in_group,
+     hot_data.location_rooms, hot_data.location_ap_ids,
+     hot_data.location_classifications, hot_data.location_panels);
+}
+
+#endif /* end of include guard: GAME_DATA_CACHE_H_5B81E3D6 */
@@ -0,0 +1,28 @@
+#include "item_unlocks_pane.h"
+
+#include "tracker_state.h"
+
+ItemUnlocksPane::ItemUnlocksPane(wxWindow* parent)
+    : wxListView(parent, wxID_ANY) {
+  AppendColumn("Item");
+  AppendColumn("Locations");
+
+  UpdateIndicators();
+}
+
+void ItemUnlocksPane::UpdateIndicators() {
+  std::shared_ptr<const std::vector<ItemUnlock>> item_unlocks =
+      GetItemUnlocks();
+
+  DeleteAllItems();
+
+  for (int i = 0; i < item_unlocks->size(); i++) {
+    const ItemUnlock& item_unlock = item_unlocks->at(i);
+
+    InsertItem(i, item_unlock.item_name);
+    SetItem(i, 1, std::to_string(item_unlock.locations));
+  }
+
+  SetColumnWidth(0, wxLIST_AUTOSIZE);
+  SetColumnWidth(1, wxLIST_AUTOSIZE_USEHEADER);
+}
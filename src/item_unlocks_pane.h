@@ -0,0 +1,19 @@
+#ifndef ITEM_UNLOCKS_PANE_H_6E2B90D1
+#define ITEM_UNLOCKS_PANE_H_6E2B90D1
+
+#include <wx/wxprec.h>
+
+#ifndef WX_PRECOMP
+#include <wx/wx.h>
+#endif
+
+#include <wx/listctrl.h>
+
+class ItemUnlocksPane : public wxListView {
+ public:
+  explicit ItemUnlocksPane(wxWindow* parent);
+
+  void UpdateIndicators();
+};
+
+#endif /* end of include guard: ITEM_UNLOCKS_PANE_H_6E2B90D1 */
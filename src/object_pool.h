@@ -0,0 +1,32 @@
+#ifndef OBJECT_POOL_H_9E47C2B1
+#define OBJECT_POOL_H_9E47C2B1
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+// Hands out shared objects again once nobody else refers to them, so that the
+// memory they own is reused rather than reallocated. Objects can be released
+// from any thread, but only one thread may acquire them.
+template <typename T>
+class ObjectPool {
+ public:
+  // Returns an object that nothing outside of the pool refers to, creating one
+  // if there is none. It still holds whatever it held when it was released.
+  std::shared_ptr<T> Acquire() {
+    for (const std::shared_ptr<T>& object : objects_) {
+      if (object.use_count() == 1) {
+        // Makes sure that whoever released the object last is done with it.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return object;
+      }
+    }
+
+    return objects_.emplace_back(std::make_shared<T>());
+  }
+
+ private:
+  std::vector<std::shared_ptr<T>> objects_;
+};
+
+#endif /* end of include guard: OBJECT_POOL_H_9E47C2B1 */
@@ -0,0 +1,285 @@
+#include "requirement_graph.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "game_data.h"
+
+Adjacency::Adjacency(const std::vector<std::vector<int>>& lists) {
+  offsets_.reserve(lists.size() + 1);
+  offsets_.push_back(0);
+
+  for (const std::vector<int>& list : lists) {
+    targets_.insert(targets_.end(), list.begin(), list.end());
+    offsets_.push_back(targets_.size());
+  }
+}
+
+RequirementGraph::RequirementGraph() {
+  const std::vector<Room>& rooms = GD_GetRooms();
+  const std::vector<Door>& doors = GD_GetDoors();
+  const std::vector<Panel>& panels = GD_GetPanels();
+  const HotGameData& hot_data = GD_GetHotData();
+
+  std::vector<std::vector<int>> room_panels(rooms.size());
+  std::vector<std::vector<int>> room_doors(rooms.size());
+  std::vector<std::vector<int>> door_panels_rev(doors.size());
+  std::vector<std::vector<int>> panel_doors(panels.size());
+  std::vector<std::vector<int>> panel_panels(panels.size());
+  std::vector<std::vector<int>> item_doors_rev;
+  std::vector<std::vector<int>> item_panels;
+
+  auto add_item = [this, &item_doors_rev, &item_panels](int ap_item_id) {
+    if (ap_item_id == -1) {
+      return -1;
+    }
+
+    auto [it, inserted] = item_index.emplace(ap_item_id, item_ids.size());
+    if (inserted) {
+      item_ids.push_back(ap_item_id);
+      item_doors_rev.emplace_back();
+      item_panels.emplace_back();
+    }
+
+    return it->second;
+  };
+
+  // Colors without an item stay at -1, and their panels can't be solved under
+  // color shuffle.
+  color_items.resize(static_cast<int>(LingoColor::kGray) + 1, -1);
+  for (LingoColor color :
+       {LingoColor::kBlack, LingoColor::kRed, LingoColor::kBlue,
+        LingoColor::kYellow, LingoColor::kGreen, LingoColor::kOrange,
+        LingoColor::kPurple, LingoColor::kBrown, LingoColor::kGray}) {
+    color_items[static_cast<int>(color)] =
+        add_item(GD_FindItemIdForColor(color));
+  }
+
+  for (int door_id = 0; door_id < doors.size(); door_id++) {
+    const Door& door_obj = doors.at(door_id);
+
+    door_panels.emplace_back(door_obj.panels);
+    room_doors[door_obj.room].push_back(door_id);
+
+    for (int panel_id : door_obj.panels) {
+      panel_doors[panel_id].push_back(door_id);
+    }
+
+    door_items.push_back(add_item(door_obj.ap_item_id));
+    door_group_items.push_back(add_item(door_obj.group_ap_item_id));
+    door_progressives.emplace_back();
+
+    for (const ProgressiveRequirement& prog_req : door_obj.progressives) {
+      int item = add_item(prog_req.ap_item_id);
+      if (item != -1) {
+        door_progressives.back().push_back(
+            {.item = item, .quantity = prog_req.quantity});
+      }
+    }
+
+    if (!hot_data.door_skip_item[door_id]) {
+      item_doors.push_back(door_id);
+
+      for (int item : {door_items.back(), door_group_items.back()}) {
+        if (item != -1) {
+          item_doors_rev[item].push_back(door_id);
+        }
+      }
+
+      for (const ItemRequirement& prog_req : door_progressives.back()) {
+        item_doors_rev[prog_req.item].push_back(door_id);
+      }
+    }
+  }
+
+  achievement_panels.Resize(panels.size());
+  counting_panels.Resize(panels.size());
+
+  for (const Panel& panel_obj : panels) {
+    panel_required_panels.emplace_back(panel_obj.required_panels);
+
+    room_panels[hot_data.panel_rooms[panel_obj.id]].push_back(panel_obj.id);
+
+    for (int room_id : panel_obj.required_rooms) {
+      room_panels[room_id].push_back(panel_obj.id);
+    }
+
+    for (int door_id : hot_data.panel_required_doors[panel_obj.id]) {
+      door_panels_rev[door_id].push_back(panel_obj.id);
+    }
+
+    for (int panel_id : panel_obj.required_panels) {
+      panel_panels[panel_id].push_back(panel_obj.id);
+    }
+
+    for (LingoColor color : hot_data.panel_colors[panel_obj.id]) {
+      int item = color_items[static_cast<int>(color)];
+      if (item != -1) {
+        item_panels[item].push_back(panel_obj.id);
+      }
+    }
+
+    if (panel_obj.achievement) {
+      achievement_panels.Set(panel_obj.id);
+    }
+
+    if (!panel_obj.non_counting) {
+      counting_panels.Set(panel_obj.id);
+    }
+
+    if (panel_obj.special == SpecialPanel::kTheMaster) {
+      master_panels.push_back(panel_obj.id);
+    } else if (panel_obj.special == SpecialPanel::kAnotherTry) {
+      another_try_panels.push_back(panel_obj.id);
+    }
+  }
+
+  room_dependent_panels = Adjacency(room_panels);
+  room_dependent_doors = Adjacency(room_doors);
+  door_dependent_panels = Adjacency(door_panels_rev);
+  panel_dependent_doors = Adjacency(panel_doors);
+  panel_dependent_panels = Adjacency(panel_panels);
+  item_dependent_doors = Adjacency(item_doors_rev);
+  item_dependent_panels = Adjacency(item_panels);
+}
+
+int RequirementGraph::FindItem(int ap_item_id) const {
+  auto it = item_index.find(ap_item_id);
+  return it == item_index.end() ? -1 : it->second;
+}
+
+ExitTable::ExitTable(const std::vector<std::vector<Exit>>* painting_exits) {
+  const std::vector<Room>& rooms = GD_GetRooms();
+
+  std::vector<std::vector<CompiledExit>> exits_by_room(rooms.size());
+  auto add_exit = [&exits_by_room](int source_room, const Exit& out_edge) {
+    exits_by_room[source_room].push_back(
+        {.source_room = source_room,
+         .destination_room = out_edge.destination_room,
+         .door = out_edge.door.value_or(-1),
+         .painting = out_edge.painting});
+  };
+
+  for (int room_id = 0; room_id < rooms.size(); room_id++) {
+    for (const Exit& out_edge : rooms.at(room_id).exits) {
+      if (!out_edge.painting || painting_exits == nullptr) {
+        add_exit(room_id, out_edge);
+      }
+    }
+
+    if (painting_exits != nullptr && room_id < painting_exits->size()) {
+      for (const Exit& out_edge : painting_exits->at(room_id)) {
+        add_exit(room_id, out_edge);
+      }
+    }
+  }
+
+  room_exit_offsets.reserve(rooms.size() + 1);
+  room_exit_offsets.push_back(0);
+
+  for (const std::vector<CompiledExit>& out_edges : exits_by_room) {
+    room_exits.insert(room_exits.end(), out_edges.begin(), out_edges.end());
+    room_exit_offsets.push_back(room_exits.size());
+  }
+
+  // Tarjan's algorithm over the exits without doors, without recursion.
+  std::vector<int> visit_index(rooms.size(), -1);
+  std::vector<int> lowlink(rooms.size(), 0);
+  std::vector<bool> on_stack(rooms.size(), false);
+  std::vector<int> room_stack;
+  std::vector<std::pair<int, size_t>> call_stack;
+  std::vector<std::vector<int>> components;
+  int next_visit_index = 0;
+
+  room_component.assign(rooms.size(), -1);
+
+  auto visit = [&](int room_id) {
+    visit_index[room_id] = next_visit_index;
+    lowlink[room_id] = next_visit_index;
+    next_visit_index++;
+
+    room_stack.push_back(room_id);
+    on_stack[room_id] = true;
+    call_stack.push_back({room_id, 0});
+  };
+
+  for (int root_id = 0; root_id < rooms.size(); root_id++) {
+    if (visit_index[root_id] != -1) {
+      continue;
+    }
+
+    visit(root_id);
+
+    while (!call_stack.empty()) {
+      int room_id = call_stack.back().first;
+      size_t edge_index = call_stack.back().second;
+
+      if (edge_index < exits_by_room[room_id].size()) {
+        call_stack.back().second++;
+
+        const CompiledExit& room_exit = exits_by_room[room_id][edge_index];
+        if (room_exit.door != -1) {
+          continue;
+        }
+
+        int next_id = room_exit.destination_room;
+        if (visit_index[next_id] == -1) {
+          visit(next_id);
+        } else if (on_stack[next_id]) {
+          lowlink[room_id] = std::min(lowlink[room_id], visit_index[next_id]);
+        }
+
+        continue;
+      }
+
+      if (lowlink[room_id] == visit_index[room_id]) {
+        components.emplace_back();
+
+        int member_id;
+        do {
+          member_id = room_stack.back();
+          room_stack.pop_back();
+          on_stack[member_id] = false;
+
+          room_component[member_id] = components.size() - 1;
+          components.back().push_back(member_id);
+        } while (member_id != room_id);
+      }
+
+      call_stack.pop_back();
+
+      if (!call_stack.empty()) {
+        int parent_id = call_stack.back().first;
+        lowlink[parent_id] = std::min(lowlink[parent_id], lowlink[room_id]);
+      }
+    }
+  }
+
+  component_rooms = Adjacency(components);
+
+  std::vector<std::vector<int>> door_exits(GD_GetDoors().size());
+
+  component_exit_offsets.reserve(components.size() + 1);
+  component_exit_offsets.push_back(0);
+
+  for (const std::vector<int>& members : components) {
+    for (int room_id : members) {
+      for (const CompiledExit& room_exit : exits_by_room[room_id]) {
+        if (room_component[room_exit.destination_room] ==
+            room_component[room_id]) {
+          continue;
+        }
+
+        if (room_exit.door != -1) {
+          door_exits[room_exit.door].push_back(exits.size());
+        }
+
+        exits.push_back(room_exit);
+      }
+    }
+
+    component_exit_offsets.push_back(exits.size());
+  }
+
+  door_dependent_exits = Adjacency(door_exits);
+}
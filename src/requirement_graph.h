@@ -0,0 +1,120 @@
+#ifndef REQUIREMENT_GRAPH_H_3D81C6E4
+#define REQUIREMENT_GRAPH_H_3D81C6E4
+
+#include <map>
+#include <span>
+#include <vector>
+
+#include "dense_bitset.h"
+#include "game_data.h"
+
+// A list of IDs for each node of a graph, stored contiguously.
+class Adjacency {
+ public:
+  Adjacency() = default;
+
+  explicit Adjacency(const std::vector<std::vector<int>>& lists);
+
+  std::span<const int> operator[](int node) const {
+    return {targets_.data() + offsets_[node],
+            targets_.data() + offsets_[node + 1]};
+  }
+
+ private:
+  std::vector<int> offsets_;
+  std::vector<int> targets_;
+};
+
+// Needs at least quantity of the item with the given dense index.
+struct ItemRequirement {
+  int item;
+  int quantity;
+};
+
+// The game data, compiled into the shape that the reachability solver works
+// on. Each room, door and panel lists the nodes that need to be re-evaluated
+// once it becomes reachable, open or solveable, respectively.
+struct RequirementGraph {
+  RequirementGraph();
+
+  // Returns the dense index of an AP item, or -1 if no requirement uses it.
+  int FindItem(int ap_item_id) const;
+
+  // Requirement lists from the game data, indexed by door or panel ID.
+  std::vector<DenseBitset::Mask> door_panels;
+  std::vector<DenseBitset::Mask> panel_required_panels;
+
+  // Panels that count towards THE MASTER and ANOTHER TRY, respectively.
+  DenseBitset achievement_panels;
+  DenseBitset counting_panels;
+
+  std::vector<int> master_panels;
+  std::vector<int> another_try_panels;
+
+  Adjacency room_dependent_panels;
+  Adjacency room_dependent_doors;
+  Adjacency door_dependent_panels;
+  Adjacency panel_dependent_doors;
+  Adjacency panel_dependent_panels;
+
+  // The AP item IDs that requirements refer to, by dense index.
+  std::vector<int> item_ids;
+  std::map<int, int> item_index;
+
+  // The items that open each door when doors are shuffled, as dense indices
+  // (-1 if there is none). The group item only applies to simple doors.
+  std::vector<int> door_items;
+  std::vector<int> door_group_items;
+  std::vector<std::vector<ItemRequirement>> door_progressives;
+
+  // Indexed by LingoColor.
+  std::vector<int> color_items;
+
+  // Doors that can be opened by an item, i.e. that don't have skip_item.
+  std::vector<int> item_doors;
+
+  // The doors and colored panels that need to be re-evaluated when more of an
+  // item is received, by dense item index.
+  Adjacency item_dependent_doors;
+  Adjacency item_dependent_panels;
+};
+
+struct CompiledExit {
+  int source_room;
+  int destination_room;
+  int door = -1;
+  bool painting = false;
+};
+
+// The room exits that are in effect for a particular slot. Which exits exist
+// depends on whether paintings are shuffled, so this is recompiled whenever
+// the slot changes.
+//
+// Rooms that are connected both ways by exits without doors are always
+// reachable together, so they are collapsed into components (the strongly
+// connected components of the door-less exits). Only the exits between
+// components are kept.
+struct ExitTable {
+  // Builds the exit table. painting_exits holds the exits out of each room
+  // created by painting shuffle; when it is null, paintings lead where they do
+  // in the base game.
+  explicit ExitTable(
+      const std::vector<std::vector<Exit>>* painting_exits = nullptr);
+
+  std::vector<int> room_component;
+  Adjacency component_rooms;
+
+  // Every exit, including the ones within a component, grouped by source room
+  // in the same way.
+  std::vector<CompiledExit> room_exits;
+  std::vector<int> room_exit_offsets;
+
+  // Exits grouped by source component; the exits out of component c are the
+  // ones in [component_exit_offsets[c], component_exit_offsets[c + 1]).
+  std::vector<CompiledExit> exits;
+  std::vector<int> component_exit_offsets;
+
+  Adjacency door_dependent_exits;
+};
+
+#endif /* end of include guard: REQUIREMENT_GRAPH_H_3D81C6E4 */
@@ -0,0 +1,112 @@
+#include "requirement_program.h"
+
+#include "game_data.h"
+
+RequirementProgram::RequirementProgram(const RequirementGraph& graph,
+                                       const LogicOptions& options,
+                                       bool ignore_soft_requirements)
+    : options_(options) {
+  const std::vector<Door>& doors = GD_GetDoors();
+  const std::vector<Panel>& panels = GD_GetPanels();
+  const HotGameData& hot_data = GD_GetHotData();
+
+  door_offsets_.reserve(doors.size() + 1);
+  door_offsets_.push_back(0);
+
+  for (int door_id = 0; door_id < doors.size(); door_id++) {
+    const Door& door_obj = doors.at(door_id);
+
+    if (options_.door_shuffle_mode == kNO_DOORS ||
+        hot_data.door_skip_item[door_id]) {
+      AddMask(RequirementOp::kRooms, DenseBitset::Mask({door_obj.room}));
+
+      if (!ignore_soft_requirements || !door_obj.is_event) {
+        AddMask(RequirementOp::kPanels, graph.door_panels[door_id]);
+      }
+    } else {
+      AddMask(RequirementOp::kItemOpenedDoors, DenseBitset::Mask({door_id}));
+    }
+
+    door_offsets_.push_back(instructions_.size());
+  }
+
+  panel_offsets_.reserve(panels.size() + 1);
+  panel_offsets_.push_back(instructions_.size());
+
+  for (const Panel& panel_obj : panels) {
+    int room_id = hot_data.panel_rooms[panel_obj.id];
+    std::span<const int> required_doors =
+        hot_data.panel_required_doors[panel_obj.id];
+
+    if (panel_obj.special == SpecialPanel::kTheMaster) {
+      AddMask(RequirementOp::kRooms, DenseBitset::Mask({room_id}));
+
+      if (!ignore_soft_requirements) {
+        AddCounter(RequirementOp::kAchievements, options_.mastery_requirement);
+      }
+    } else if (panel_obj.special == SpecialPanel::kAnotherTry &&
+               options_.victory_condition == kLEVEL_2) {
+      AddMask(RequirementOp::kRooms, DenseBitset::Mask({room_id}));
+
+      if (!ignore_soft_requirements) {
+        AddCounter(RequirementOp::kCountingPanels,
+                   options_.level_2_requirement - 1);
+      }
+    } else {
+      std::vector<int> rooms = {room_id};
+      if (!ignore_soft_requirements) {
+        rooms.insert(rooms.end(), panel_obj.required_rooms.begin(),
+                     panel_obj.required_rooms.end());
+      }
+
+      AddMask(RequirementOp::kRooms, DenseBitset::Mask(rooms));
+
+      if (!ignore_soft_requirements) {
+        AddMask(RequirementOp::kDoors, DenseBitset::Mask(required_doors));
+        AddMask(RequirementOp::kPanels,
+                graph.panel_required_panels[panel_obj.id]);
+      } else if (options_.door_shuffle_mode != kNO_DOORS) {
+        std::vector<int> item_doors;
+        for (int door_id : required_doors) {
+          if (!hot_data.door_skip_item[door_id]) {
+            item_doors.push_back(door_id);
+          }
+        }
+
+        AddMask(RequirementOp::kDoors, DenseBitset::Mask(item_doors));
+      }
+
+      if (options_.color_shuffle) {
+        std::vector<int> items;
+        for (LingoColor color : hot_data.panel_colors[panel_obj.id]) {
+          int item = graph.color_items[static_cast<int>(color)];
+          if (item == -1) {
+            instructions_.push_back({.op = RequirementOp::kNever});
+          } else {
+            items.push_back(item);
+          }
+        }
+
+        AddMask(RequirementOp::kItems, DenseBitset::Mask(items));
+      }
+    }
+
+    panel_offsets_.push_back(instructions_.size());
+  }
+}
+
+void RequirementProgram::AddMask(RequirementOp op,
+                                 const DenseBitset::Mask& mask) {
+  for (const auto& [word, bits] : mask.words()) {
+    instructions_.push_back(
+        {.op = op, .word = static_cast<uint32_t>(word), .bits = bits});
+  }
+}
+
+void RequirementProgram::AddCounter(RequirementOp op, int threshold) {
+  // A counter can't be negative, so these always pass.
+  if (threshold > 0) {
+    instructions_.push_back(
+        {.op = op, .bits = static_cast<uint64_t>(threshold)});
+  }
+}
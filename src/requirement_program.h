@@ -0,0 +1,82 @@
+#ifndef REQUIREMENT_PROGRAM_H_E5C2874B
+#define REQUIREMENT_PROGRAM_H_E5C2874B
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "ap_state.h"
+#include "requirement_graph.h"
+
+// The slot options that the logic depends on. These are read once, when the
+// slot connects, rather than during every evaluation.
+struct LogicOptions {
+  DoorShuffleMode door_shuffle_mode = kNO_DOORS;
+  bool color_shuffle = false;
+  int mastery_requirement = 21;
+  int level_2_requirement = 223;
+  VictoryCondition victory_condition = kTHE_END;
+  bool early_color_hallways = false;
+};
+
+// What an instruction tests. The bitset operations check that every bit in
+// bits is set in the given word of the solver's bitset of that kind; the
+// counter operations check that the counter is at least bits.
+enum class RequirementOp : uint8_t {
+  kRooms,
+  kDoors,
+  kPanels,
+  kItemOpenedDoors,
+  kItems,
+  kAchievements,
+  kCountingPanels,
+  kNever,
+};
+
+struct RequirementInstruction {
+  RequirementOp op;
+  uint32_t word = 0;
+  uint64_t bits = 0;
+};
+
+// Every door's and panel's requirements, flattened into one contiguous list
+// of instructions that all have to pass. Checks that cannot apply under the
+// given options are left out, so this has to be recompiled when they change.
+//
+// With ignore_soft_requirements, only what physically stands in the way is
+// kept: being in the panel's room, doors opened by items, and colors. The
+// rooms and panels that a panel requires only tell where its answer can be
+// learned, so they are left out, as are the doors it requires that aren't
+// opened by an item, the achievement and counting panel thresholds, and the
+// panels that open event doors. This gives the out-of-logic layer that
+// sequence breaks can reach.
+class RequirementProgram {
+ public:
+  RequirementProgram() = default;
+
+  RequirementProgram(const RequirementGraph& graph, const LogicOptions& options,
+                     bool ignore_soft_requirements = false);
+
+  const LogicOptions& options() const { return options_; }
+
+  std::span<const RequirementInstruction> door(int door_id) const {
+    return {instructions_.data() + door_offsets_[door_id],
+            instructions_.data() + door_offsets_[door_id + 1]};
+  }
+
+  std::span<const RequirementInstruction> panel(int panel_id) const {
+    return {instructions_.data() + panel_offsets_[panel_id],
+            instructions_.data() + panel_offsets_[panel_id + 1]};
+  }
+
+ private:
+  void AddMask(RequirementOp op, const DenseBitset::Mask& mask);
+  void AddCounter(RequirementOp op, int threshold);
+
+  LogicOptions options_;
+  std::vector<RequirementInstruction> instructions_;
+  std::vector<int> door_offsets_;
+  std::vector<int> panel_offsets_;
+};
+
+#endif /* end of include guard: REQUIREMENT_PROGRAM_H_E5C2874B */
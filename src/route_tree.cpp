@@ -0,0 +1,57 @@
+#include "route_tree.h"
+
+#include <algorithm>
+
+void RouteTree::Rebuild(const ExitTable& exit_table,
+                        const std::vector<int>& start_rooms,
+                        const DenseBitset& open_doors) {
+  int room_count = exit_table.room_exit_offsets.size() - 1;
+  reached_.Resize(room_count);
+  entry_exits_.assign(room_count, {.source_room = -1, .destination_room = -1});
+
+  room_queue_.clear();
+  room_queue_.reserve(room_count);
+
+  for (int room_id : start_rooms) {
+    if (!reached_.Test(room_id)) {
+      reached_.Set(room_id);
+      room_queue_.push_back(room_id);
+    }
+  }
+
+  for (size_t queue_index = 0; queue_index < room_queue_.size();
+       queue_index++) {
+    int room_id = room_queue_[queue_index];
+
+    for (int exit_index = exit_table.room_exit_offsets[room_id];
+         exit_index < exit_table.room_exit_offsets[room_id + 1];
+         exit_index++) {
+      const CompiledExit& room_exit = exit_table.room_exits[exit_index];
+
+      if (reached_.Test(room_exit.destination_room) ||
+          (room_exit.door != -1 && !open_doors.Test(room_exit.door))) {
+        continue;
+      }
+
+      reached_.Set(room_exit.destination_room);
+      entry_exits_[room_exit.destination_room] = room_exit;
+      room_queue_.push_back(room_exit.destination_room);
+    }
+  }
+}
+
+std::vector<CompiledExit> RouteTree::GetRoute(int room_id) const {
+  std::vector<CompiledExit> route;
+  if (!reached_.Test(room_id)) {
+    return route;
+  }
+
+  while (entry_exits_[room_id].source_room != -1) {
+    route.push_back(entry_exits_[room_id]);
+    room_id = entry_exits_[room_id].source_room;
+  }
+
+  std::reverse(route.begin(), route.end());
+
+  return route;
+}
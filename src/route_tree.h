@@ -0,0 +1,35 @@
+#ifndef ROUTE_TREE_H_5C93E1F7
+#define ROUTE_TREE_H_5C93E1F7
+
+#include <vector>
+
+#include "dense_bitset.h"
+#include "requirement_graph.h"
+
+// The shortest routes from the start to every room that can be reached
+// through the exits whose doors are open, as a breadth-first search tree.
+// Looking up a route only follows the tree back to the start, so this is
+// cheap enough to do on every mouse movement.
+class RouteTree {
+ public:
+  // Replaces the routes, reusing the memory from the previous ones.
+  void Rebuild(const ExitTable& exit_table, const std::vector<int>& start_rooms,
+               const DenseBitset& open_doors);
+
+  bool IsReachable(int room_id) const { return reached_.Test(room_id); }
+
+  // The exits taken on the way to the room, in order. Empty if the room is a
+  // start room, or if it cannot be reached.
+  std::vector<CompiledExit> GetRoute(int room_id) const;
+
+ private:
+  DenseBitset reached_;
+
+  // The exit that each room is entered through on its shortest route. The
+  // start rooms have a source room of -1.
+  std::vector<CompiledExit> entry_exits_;
+
+  std::vector<int> room_queue_;
+};
+
+#endif /* end of include guard: ROUTE_TREE_H_5C93E1F7 */
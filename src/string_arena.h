@@ -0,0 +1,52 @@
+#ifndef STRING_ARENA_H_3FA2D87C
+#define STRING_ARENA_H_3FA2D87C
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+// Keeps a single copy of every distinct string given to it, packed into large
+// blocks. The views that it hands out stay valid for as long as the arena
+// does, and two of them are equal exactly if they point at the same memory.
+class StringArena {
+ public:
+  std::string_view Intern(std::string_view str) {
+    auto it = interned_.find(str);
+    if (it != interned_.end()) {
+      return *it;
+    }
+
+    if (blocks_.empty() || block_size_ - block_used_ < str.size()) {
+      block_size_ = std::max(kBlockSize, str.size());
+      block_used_ = 0;
+      blocks_.push_back(std::make_unique<char[]>(block_size_));
+    }
+
+    char* copy = blocks_.back().get() + block_used_;
+    std::memcpy(copy, str.data(), str.size());
+    block_used_ += str.size();
+
+    std::string_view interned(copy, str.size());
+    interned_.insert(interned);
+    return interned;
+  }
+
+  // Like Intern, but a string that isn't in the arena yet is used where it
+  // is instead of being copied. It has to outlive the arena.
+  std::string_view Adopt(std::string_view str) {
+    return *interned_.insert(str).first;
+  }
+
+ private:
+  static constexpr size_t kBlockSize = 64 * 1024;
+
+  std::vector<std::unique_ptr<char[]>> blocks_;
+  size_t block_size_ = 0;
+  size_t block_used_ = 0;
+  std::unordered_set<std::string_view> interned_;
+};
+
+#endif /* end of include guard: STRING_ARENA_H_3FA2D87C */
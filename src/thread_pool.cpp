@@ -0,0 +1,56 @@
+#include "thread_pool.h"
+
+#include <thread>
+
+ThreadPool::ThreadPool(int num_threads) : num_threads_(num_threads) {
+  for (int i = 0; i < num_threads_; i++) {
+    std::thread([this]() { WorkerLoop(); }).detach();
+  }
+}
+
+void ThreadPool::ParallelFor(int count,
+                             const std::function<void(int)>& task) {
+  std::lock_guard run_guard(run_mutex_);
+  std::unique_lock lock(mutex_);
+
+  task_ = &task;
+  count_ = count;
+  next_index_ = 0;
+  busy_workers_ = num_threads_;
+  generation_++;
+
+  work_cv_.notify_all();
+  done_cv_.wait(lock, [this]() { return busy_workers_ == 0; });
+
+  task_ = nullptr;
+}
+
+void ThreadPool::WorkerLoop() {
+  uint64_t last_generation = 0;
+
+  for (;;) {
+    const std::function<void(int)>* task = nullptr;
+    int count = 0;
+    {
+      std::unique_lock lock(mutex_);
+      work_cv_.wait(lock, [this, last_generation]() {
+        return generation_ != last_generation;
+      });
+
+      last_generation = generation_;
+      task = task_;
+      count = count_;
+    }
+
+    for (int i = next_index_++; i < count; i = next_index_++) {
+      (*task)(i);
+    }
+
+    {
+      std::lock_guard lock(mutex_);
+      busy_workers_--;
+    }
+
+    done_cv_.notify_one();
+  }
+}
@@ -0,0 +1,41 @@
+#ifndef THREAD_POOL_H_A47C19E2
+#define THREAD_POOL_H_A47C19E2
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+// A fixed set of worker threads that lives for the rest of the program.
+class ThreadPool {
+ public:
+  explicit ThreadPool(int num_threads);
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  // Calls task(i) for every i in [0, count), spread across the workers, and
+  // returns once all of the calls have finished. Calls from different threads
+  // are run one after another.
+  void ParallelFor(int count, const std::function<void(int)>& task);
+
+ private:
+  void WorkerLoop();
+
+  int num_threads_;
+
+  std::mutex run_mutex_;
+
+  std::mutex mutex_;
+  std::condition_variable work_cv_;
+  std::condition_variable done_cv_;
+  uint64_t generation_ = 0;
+  const std::function<void(int)>* task_ = nullptr;
+  int count_ = 0;
+  int busy_workers_ = 0;
+
+  std::atomic<int> next_index_ = 0;
+};
+
+#endif /* end of include guard: THREAD_POOL_H_A47C19E2 */
@@ -9,6 +9,7 @@
 #include "achievements_pane.h"
 #include "ap_state.h"
 #include "connection_dialog.h"
+#include "item_unlocks_pane.h"
 #include "tracker_config.h"
 #include "tracker_panel.h"
 #include "version.h"
@@ -17,6 +18,7 @@ enum TrackerFrameIds { ID_CONNECT = 1, ID_CHECK_FOR_UPDATES = 2 };
 
 wxDEFINE_EVENT(STATE_CHANGED, wxCommandEvent);
 wxDEFINE_EVENT(STATUS_CHANGED, wxCommandEvent);
+wxDEFINE_EVENT(ITEM_UNLOCKS_CHANGED, wxCommandEvent);
 
 TrackerFrame::TrackerFrame()
     : wxFrame(nullptr, wxID_ANY, "Lingo Archipelago Tracker", wxDefaultPosition,
@@ -51,10 +53,13 @@ TrackerFrame::TrackerFrame()
        ID_CHECK_FOR_UPDATES);
   Bind(STATE_CHANGED, &TrackerFrame::OnStateChanged, this);
   Bind(STATUS_CHANGED, &TrackerFrame::OnStatusChanged, this);
+  Bind(ITEM_UNLOCKS_CHANGED, &TrackerFrame::OnItemUnlocksChanged, this);
 
   wxChoicebook *choicebook = new wxChoicebook(this, wxID_ANY);
   achievements_pane_ = new AchievementsPane(this);
   choicebook->AddPage(achievements_pane_, "Achievements");
+  item_unlocks_pane_ = new ItemUnlocksPane(this);
+  choicebook->AddPage(item_unlocks_pane_, "Item Unlocks");
 
   tracker_panel_ = new TrackerPanel(this);
 
@@ -94,6 +99,10 @@ void TrackerFrame::UpdateIndicators() {
   QueueEvent(new wxCommandEvent(STATE_CHANGED));
 }
 
+void TrackerFrame::UpdateItemUnlocks() {
+  QueueEvent(new wxCommandEvent(ITEM_UNLOCKS_CHANGED));
+}
+
 void TrackerFrame::OnAbout(wxCommandEvent &event) {
   std::ostringstream message_text;
   message_text << "Lingo Archipelago Tracker " << kTrackerVersion
@@ -126,13 +135,16 @@ void TrackerFrame::OnCheckForUpdates(wxCommandEvent &event) {
 void TrackerFrame::OnStateChanged(wxCommandEvent &event) {
   tracker_panel_->UpdateIndicators();
   achievements_pane_->UpdateIndicators();
-  Refresh();
 }
 
 void TrackerFrame::OnStatusChanged(wxCommandEvent &event) {
   SetStatusText(event.GetString());
 }
 
+void TrackerFrame::OnItemUnlocksChanged(wxCommandEvent &event) {
+  item_unlocks_pane_->UpdateIndicators();
+}
+
 void TrackerFrame::CheckForUpdates(bool manual) {
   wxWebRequest request = wxWebSession::GetDefault().CreateRequest(
       this,
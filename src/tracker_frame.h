@@ -8,10 +8,12 @@
 #endif
 
 class AchievementsPane;
+class ItemUnlocksPane;
 class TrackerPanel;
 
 wxDECLARE_EVENT(STATE_CHANGED, wxCommandEvent);
 wxDECLARE_EVENT(STATUS_CHANGED, wxCommandEvent);
+wxDECLARE_EVENT(ITEM_UNLOCKS_CHANGED, wxCommandEvent);
 
 class TrackerFrame : public wxFrame {
  public:
@@ -21,6 +23,8 @@ class TrackerFrame : public wxFrame {
 
   void UpdateIndicators();
 
+  void UpdateItemUnlocks();
+
  private:
   void OnExit(wxCommandEvent &event);
   void OnAbout(wxCommandEvent &event);
@@ -29,11 +33,13 @@ class TrackerFrame : public wxFrame {
 
   void OnStateChanged(wxCommandEvent &event);
   void OnStatusChanged(wxCommandEvent &event);
+  void OnItemUnlocksChanged(wxCommandEvent &event);
 
   void CheckForUpdates(bool manual);
 
   TrackerPanel *tracker_panel_;
   AchievementsPane *achievements_pane_;
+  ItemUnlocksPane *item_unlocks_pane_;
 };
 
 #endif /* end of include guard: TRACKER_FRAME_H_86BD8DFB */
@@ -1,5 +1,7 @@
 #include "tracker_panel.h"
 
+#include <algorithm>
+
 #include "ap_state.h"
 #include "area_popup.h"
 #include "game_data.h"
@@ -15,7 +17,17 @@ TrackerPanel::TrackerPanel(wxWindow *parent) : wxPanel(parent, wxID_ANY) {
     return;
   }
 
+  room_areas_.assign(GD_GetRooms().size(), -1);
+
+  const HotGameData &hot_data = GD_GetHotData();
   for (const MapArea &map_area : GD_GetMapAreas()) {
+    for (const Location &location : map_area.locations) {
+      int room_id = hot_data.location_rooms[location.id];
+      if (room_areas_[room_id] == -1) {
+        room_areas_[room_id] = map_area.id;
+      }
+    }
+
     AreaIndicator area;
     area.area_id = map_area.id;
 
@@ -25,6 +37,7 @@ TrackerPanel::TrackerPanel(wxWindow *parent) : wxPanel(parent, wxID_ANY) {
     areas_.push_back(area);
   }
 
+  displayed_ = GetReachabilitySnapshot();
   Redraw();
 
   Bind(wxEVT_PAINT, &TrackerPanel::OnPaint, this);
@@ -32,10 +45,61 @@ TrackerPanel::TrackerPanel(wxWindow *parent) : wxPanel(parent, wxID_ANY) {
 }
 
 void TrackerPanel::UpdateIndicators() {
-  Redraw();
+  std::shared_ptr<const ReachabilitySnapshot> reachability =
+      GetReachabilitySnapshot();
+  if (reachability == displayed_) {
+    return;
+  }
+
+  // The snapshot only lists what changed since the version before it, so
+  // everything has to be redrawn if a version was skipped. The same goes for
+  // when areas have been shown or hidden, e.g. after connecting to a slot.
+  bool full_update = !displayed_ || !rendered_.IsOk() ||
+                     reachability->version != displayed_->version + 1 ||
+                     std::any_of(areas_.begin(), areas_.end(),
+                                 [](const AreaIndicator &area) {
+                                   return area.active !=
+                                          AP_IsLocationVisible(
+                                              GD_GetMapArea(area.area_id)
+                                                  .classification);
+                                 });
+  displayed_ = reachability;
+
+  if (full_update) {
+    for (AreaIndicator &area : areas_) {
+      area.popup->UpdateIndicators(*displayed_);
+    }
+
+    Redraw();
+    Refresh();
+    return;
+  }
+
+  wxMemoryDC dc;
+  dc.SelectObject(rendered_);
 
   for (AreaIndicator &area : areas_) {
-    area.popup->UpdateIndicators();
+    const MapArea &map_area = GD_GetMapArea(area.area_id);
+    if (std::none_of(map_area.locations.begin(), map_area.locations.end(),
+                     [this](const Location &location) {
+                       return displayed_->changed_locations.Test(location.id);
+                     })) {
+      continue;
+    }
+
+    area.popup->UpdateIndicators(*displayed_);
+
+    if (area.active) {
+      DrawAreaIndicator(dc, area);
+      PlacePopup(area);
+      RefreshRect({area.real_x1, area.real_y1, area.real_x2 - area.real_x1,
+                   area.real_y2 - area.real_y1});
+    }
+  }
+
+  // The route to the hovered area can change even if no area has.
+  if (hovered_area_ != -1) {
+    Refresh();
   }
 }
 
@@ -47,20 +111,32 @@ void TrackerPanel::OnPaint(wxPaintEvent &event) {
   wxPaintDC dc(this);
   dc.DrawBitmap(rendered_, 0, 0);
 
+  if (hovered_area_ != -1) {
+    DrawRoute(dc);
+  }
+
   event.Skip();
 }
 
 void TrackerPanel::OnMouseMove(wxMouseEvent &event) {
+  int hovered_area = -1;
+
   for (AreaIndicator &area : areas_) {
     if (area.active && area.real_x1 <= event.GetX() &&
         event.GetX() < area.real_x2 && area.real_y1 <= event.GetY() &&
         event.GetY() < area.real_y2) {
       area.popup->Show();
+      hovered_area = area.area_id;
     } else {
       area.popup->Hide();
     }
   }
 
+  if (hovered_area != hovered_area_) {
+    hovered_area_ = hovered_area;
+    Refresh();
+  }
+
   event.Skip();
 }
 
@@ -92,8 +168,6 @@ void TrackerPanel::Redraw() {
   dc.SelectObject(rendered_);
 
   for (AreaIndicator &area : areas_) {
-    const wxBrush *brush_color = wxGREY_BRUSH;
-
     const MapArea &map_area = GD_GetMapArea(area.area_id);
     if (!AP_IsLocationVisible(map_area.classification)) {
       area.active = false;
@@ -102,60 +176,159 @@ void TrackerPanel::Redraw() {
       area.active = true;
     }
 
-    bool has_reachable_unchecked = false;
-    bool has_unreachable_unchecked = false;
-    for (const Location &section : map_area.locations) {
-      if (AP_IsLocationVisible(section.classification) &&
-          !AP_HasCheckedGameLocation(section.ap_location_id)) {
-        if (IsLocationReachable(section.ap_location_id)) {
-          has_reachable_unchecked = true;
-        } else {
-          has_unreachable_unchecked = true;
-        }
-      }
-    }
-
-    if (has_reachable_unchecked && has_unreachable_unchecked) {
-      brush_color = wxYELLOW_BRUSH;
-    } else if (has_reachable_unchecked) {
-      brush_color = wxGREEN_BRUSH;
-    } else if (has_unreachable_unchecked) {
-      brush_color = wxRED_BRUSH;
-    }
-
     int real_area_size =
         final_width * AREA_EFFECTIVE_SIZE / image_size.GetWidth();
-    int actual_border_size =
-        real_area_size * AREA_BORDER_SIZE / AREA_EFFECTIVE_SIZE;
     int real_area_x = final_x + (map_area.map_x - (AREA_EFFECTIVE_SIZE / 2)) *
                                     final_width / image_size.GetWidth();
     int real_area_y = final_y + (map_area.map_y - (AREA_EFFECTIVE_SIZE / 2)) *
                                     final_width / image_size.GetWidth();
 
-    dc.SetPen(*wxThePenList->FindOrCreatePen(*wxBLACK, actual_border_size));
-    dc.SetBrush(*brush_color);
-    dc.DrawRectangle({real_area_x, real_area_y},
-                     {real_area_size, real_area_size});
-
     area.real_x1 = real_area_x;
     area.real_x2 = real_area_x + real_area_size;
     area.real_y1 = real_area_y;
     area.real_y2 = real_area_y + real_area_size;
 
-    int popup_x =
+    area.popup_x =
         final_x + map_area.map_x * final_width / image_size.GetWidth();
-    int popup_y =
+    area.popup_y =
         final_y + map_area.map_y * final_width / image_size.GetWidth();
 
-    area.popup->SetMaxSize(panel_size);
-    area.popup->GetSizer()->Fit(area.popup);
+    DrawAreaIndicator(dc, area);
+    PlacePopup(area);
+  }
+}
+
+void TrackerPanel::DrawAreaIndicator(wxDC &dc, const AreaIndicator &area) {
+  const wxBrush *brush_color = wxGREY_BRUSH;
 
-    if (popup_x + area.popup->GetSize().GetWidth() > panel_size.GetWidth()) {
-      popup_x = panel_size.GetWidth() - area.popup->GetSize().GetWidth();
+  bool has_reachable_unchecked = false;
+  bool has_unreachable_unchecked = false;
+  bool has_out_of_logic_unchecked = false;
+  const HotGameData &hot_data = GD_GetHotData();
+  for (const Location &section : GD_GetMapArea(area.area_id).locations) {
+    if (AP_IsLocationVisible(hot_data.location_classifications[section.id]) &&
+        !displayed_->checked_locations.Test(section.id)) {
+      if (displayed_->reachable_locations.Test(section.id)) {
+        has_reachable_unchecked = true;
+      } else {
+        has_unreachable_unchecked = true;
+
+        if (displayed_->out_of_logic_locations.Test(section.id)) {
+          has_out_of_logic_unchecked = true;
+        }
+      }
     }
-    if (popup_y + area.popup->GetSize().GetHeight() > panel_size.GetHeight()) {
-      popup_y = panel_size.GetHeight() - area.popup->GetSize().GetHeight();
+  }
+
+  if (has_reachable_unchecked && has_unreachable_unchecked) {
+    brush_color = wxYELLOW_BRUSH;
+  } else if (has_reachable_unchecked) {
+    brush_color = wxGREEN_BRUSH;
+  } else if (has_out_of_logic_unchecked) {
+    brush_color =
+        wxTheBrushList->FindOrCreateBrush(wxTheColourDatabase->Find("ORANGE"));
+  } else if (has_unreachable_unchecked) {
+    brush_color = wxRED_BRUSH;
+  }
+
+  int real_area_size = area.real_x2 - area.real_x1;
+  int actual_border_size =
+      real_area_size * AREA_BORDER_SIZE / AREA_EFFECTIVE_SIZE;
+
+  dc.SetPen(*wxThePenList->FindOrCreatePen(*wxBLACK, actual_border_size));
+  dc.SetBrush(*brush_color);
+  dc.DrawRectangle({area.real_x1, area.real_y1},
+                   {real_area_size, real_area_size});
+}
+
+void TrackerPanel::PlacePopup(AreaIndicator &area) {
+  wxSize panel_size = GetSize();
+
+  area.popup->SetMaxSize(panel_size);
+  area.popup->GetSizer()->Fit(area.popup);
+
+  int popup_x = area.popup_x;
+  int popup_y = area.popup_y;
+
+  if (popup_x + area.popup->GetSize().GetWidth() > panel_size.GetWidth()) {
+    popup_x = panel_size.GetWidth() - area.popup->GetSize().GetWidth();
+  }
+  if (popup_y + area.popup->GetSize().GetHeight() > panel_size.GetHeight()) {
+    popup_y = panel_size.GetHeight() - area.popup->GetSize().GetHeight();
+  }
+  area.popup->SetPosition({popup_x, popup_y});
+}
+
+void TrackerPanel::DrawRoute(wxDC &dc) {
+  const ReachabilitySnapshot &reachability = *displayed_;
+  if (!reachability.routes) {
+    return;
+  }
+
+  // Head for the nearest reachable location in the area, preferring ones that
+  // have not been checked yet.
+  const MapArea &map_area = GD_GetMapArea(hovered_area_);
+  std::vector<CompiledExit> route;
+  bool found = false;
+  bool found_unchecked = false;
+
+  const HotGameData &hot_data = GD_GetHotData();
+  for (const Location &location : map_area.locations) {
+    int room_id = hot_data.location_rooms[location.id];
+    if (!AP_IsLocationVisible(
+            hot_data.location_classifications[location.id]) ||
+        !reachability.routes->IsReachable(room_id)) {
+      continue;
+    }
+
+    bool unchecked = !reachability.checked_locations.Test(location.id);
+    if (found && found_unchecked && !unchecked) {
+      continue;
+    }
+
+    std::vector<CompiledExit> location_route =
+        reachability.routes->GetRoute(room_id);
+    if (!found || (unchecked && !found_unchecked) ||
+        location_route.size() < route.size()) {
+      route = std::move(location_route);
+      found = true;
+      found_unchecked = unchecked;
+    }
+  }
+
+  if (route.empty()) {
+    return;
+  }
+
+  // Only rooms with a location in them have a place on the map, so the route
+  // is drawn between the areas it passes through. Legs that go through a
+  // painting are dashed.
+  auto area_center = [this](int area_id) {
+    const AreaIndicator &area = areas_.at(area_id);
+    return wxPoint((area.real_x1 + area.real_x2) / 2,
+                   (area.real_y1 + area.real_y2) / 2);
+  };
+
+  int previous_area = room_areas_[route.front().source_room];
+  bool through_painting = false;
+
+  for (const CompiledExit &room_exit : route) {
+    through_painting = through_painting || room_exit.painting;
+
+    int next_area = room_areas_[room_exit.destination_room];
+    if (next_area == -1 || !areas_.at(next_area).active ||
+        next_area == previous_area) {
+      continue;
     }
-    area.popup->SetPosition({popup_x, popup_y});
+
+    if (previous_area != -1 && areas_.at(previous_area).active) {
+      dc.SetPen(*wxThePenList->FindOrCreatePen(
+          *wxCYAN, 3,
+          through_painting ? wxPENSTYLE_SHORT_DASH : wxPENSTYLE_SOLID));
+      dc.DrawLine(area_center(previous_area), area_center(next_area));
+    }
+
+    previous_area = next_area;
+    through_painting = false;
   }
 }
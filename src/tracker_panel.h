@@ -7,7 +7,11 @@
 #include <wx/wx.h>
 #endif
 
+#include <memory>
+#include <vector>
+
 class AreaPopup;
+struct ReachabilitySnapshot;
 
 class TrackerPanel : public wxPanel {
  public:
@@ -23,6 +27,8 @@ class TrackerPanel : public wxPanel {
     int real_y1 = 0;
     int real_x2 = 0;
     int real_y2 = 0;
+    int popup_x = 0;
+    int popup_y = 0;
     bool active = true;
   };
  
@@ -30,11 +36,21 @@ class TrackerPanel : public wxPanel {
   void OnMouseMove(wxMouseEvent &event);
 
   void Redraw();
+  void DrawAreaIndicator(wxDC &dc, const AreaIndicator &area);
+  void PlacePopup(AreaIndicator &area);
+  void DrawRoute(wxDC &dc);
 
   wxImage map_image_;
   wxBitmap rendered_;
 
   std::vector<AreaIndicator> areas_;
+  int hovered_area_ = -1;
+
+  // The snapshot that the map and popups currently show.
+  std::shared_ptr<const ReachabilitySnapshot> displayed_;
+
+  // The first map area that has a location in each room, or -1.
+  std::vector<int> room_areas_;
 };
 
 #endif /* end of include guard: TRACKER_PANEL_H_D675A54D */
@@ -1,259 +1,962 @@
 #include "tracker_state.h"
 
-#include <list>
+#include <algorithm>
+#include <atomic>
 #include <map>
 #include <mutex>
-#include <set>
+#include <span>
 #include <sstream>
+#include <thread>
 #include <tuple>
+#include <vector>
 
 #include "ap_state.h"
+#include "dense_bitset.h"
 #include "game_data.h"
+#include "object_pool.h"
+#include "requirement_graph.h"
+#include "requirement_program.h"
+#include "thread_pool.h"
 
 namespace {
 
-struct TrackerState {
-  std::map<int, bool> reachability;
-  std::mutex reachability_mutex;
-};
-
-enum Decision { kYes, kNo, kMaybe };
+std::string GetColorName(LingoColor color) {
+  switch (color) {
+    case LingoColor::kBlack:
+      return "Black";
+    case LingoColor::kRed:
+      return "Red";
+    case LingoColor::kBlue:
+      return "Blue";
+    case LingoColor::kYellow:
+      return "Yellow";
+    case LingoColor::kGreen:
+      return "Green";
+    case LingoColor::kOrange:
+      return "Orange";
+    case LingoColor::kPurple:
+      return "Purple";
+    case LingoColor::kBrown:
+      return "Brown";
+    case LingoColor::kGray:
+      return "Gray";
+    default:
+      return "";
+  }
+}
 
-TrackerState& GetState() {
-  static TrackerState* instance = new TrackerState();
-  return *instance;
+LogicOptions GetLogicOptions() {
+  return {.door_shuffle_mode = AP_GetDoorShuffleMode(),
+          .color_shuffle = AP_IsColorShuffle(),
+          .mastery_requirement = AP_GetMasteryRequirement(),
+          .level_2_requirement = AP_GetLevel2Requirement(),
+          .victory_condition = AP_GetVictoryCondition(),
+          .early_color_hallways = AP_HasEarlyColorHallways()};
 }
 
-Decision IsDoorReachable_Helper(int door_id,
-                                const std::set<int>& reachable_rooms,
-                                const std::set<int>& solveable_panels) {
-  const Door& door_obj = GD_GetDoor(door_id);
+// The logic state for one inventory. The game data, exit table and
+// requirement program are shared rather than owned, so this is cheap to copy,
+// which is how hypothetical inventories are evaluated without touching the
+// real one.
+struct Solver {
+  Solver(const RequirementGraph& graph_arg, const ExitTable& exit_table_arg,
+         const RequirementProgram& program_arg)
+      : graph(graph_arg), exit_table(exit_table_arg), program(program_arg) {}
+
+  const RequirementGraph& graph;
+  const ExitTable& exit_table;
+  const RequirementProgram& program;
+
+  // How many of each item have been received, by dense item index.
+  std::vector<int> item_counts;
+  DenseBitset received_items;
+
+  // The doors whose item requirement is met by item_counts. This is updated
+  // whenever an item count changes, so door checks never look at the
+  // inventory.
+  DenseBitset item_opened_doors;
+
+  // The fixpoint from the previous recalculation. Items only ever get added to
+  // the inventory while a slot is connected, so the reachable set can only
+  // grow, and the next recalculation can resume from here instead of flooding
+  // out from the Menu again.
+  bool has_fixpoint = false;
+  DenseBitset reachable_rooms;
+  DenseBitset solveable_panels;
+  DenseBitset open_doors;
+
+  // How many achievement and counting panels are solveable. THE MASTER and
+  // ANOTHER TRY are re-evaluated when these reach their requirements.
+  int achievements_solveable = 0;
+  int counting_panels_solveable = 0;
+
+  // Nodes that need to be re-evaluated because one of their inputs changed.
+  std::vector<int> exit_worklist;
+  std::vector<int> door_worklist;
+  std::vector<int> panel_worklist;
+
+  // The instantiation of SetItemCount_Impl for the slot's options, picked in
+  // Reset.
+  using SetItemCountFn = void (Solver::*)(int, int);
+  SetItemCountFn set_item_count = nullptr;
+
+  void Reset() {
+    set_item_count = SelectSetItemCount(program.options());
+
+    item_counts.assign(graph.item_ids.size(), 0);
+    received_items.Resize(graph.item_ids.size());
+    item_opened_doors.Resize(GD_GetDoors().size());
+
+    reachable_rooms.Resize(GD_GetRooms().size());
+    solveable_panels.Resize(GD_GetPanels().size());
+    open_doors.Resize(GD_GetDoors().size());
+    achievements_solveable = 0;
+    counting_panels_solveable = 0;
+
+    exit_worklist.clear();
+    door_worklist.clear();
+    panel_worklist.clear();
+
+    has_fixpoint = false;
+  }
+
+  // Copies everything but the graph, exit table and program, which have to be
+  // the same ones. Unlike a copy, this reuses the memory that this solver
+  // already owns.
+  void CopyStateFrom(const Solver& other) {
+    item_counts = other.item_counts;
+    received_items = other.received_items;
+    item_opened_doors = other.item_opened_doors;
+    has_fixpoint = other.has_fixpoint;
+    reachable_rooms = other.reachable_rooms;
+    solveable_panels = other.solveable_panels;
+    open_doors = other.open_doors;
+    achievements_solveable = other.achievements_solveable;
+    counting_panels_solveable = other.counting_panels_solveable;
+    exit_worklist = other.exit_worklist;
+    door_worklist = other.door_worklist;
+    panel_worklist = other.panel_worklist;
+    set_item_count = other.set_item_count;
+  }
 
-  if (AP_GetDoorShuffleMode() == kNO_DOORS || door_obj.skip_item) {
-    if (!reachable_rooms.count(door_obj.room)) {
-      return kMaybe;
+  void ReceiveItem(int64_t ap_item_id, int count) {
+    int item = graph.FindItem(ap_item_id);
+    if (item != -1) {
+      SetItemCount(item, count);
     }
+  }
 
-    for (int panel_id : door_obj.panels) {
-      if (!solveable_panels.count(panel_id)) {
-        return kMaybe;
+  // Queues the nodes that depend on the item. The new count only takes effect
+  // in the next call to Recalculate.
+  void SetItemCount(int item, int count) {
+    (this->*set_item_count)(item, count);
+  }
+
+  void Recalculate() {
+    // Between recalculations, only nodes that depend on items can change, and
+    // those have already been queued by SetItemCount.
+    if (!has_fixpoint) {
+      ReachRoom(GD_GetRoomByName("Menu"));
+
+      if (program.options().early_color_hallways) {
+        ReachRoom(GD_GetRoomByName("Outside The Undeterred"));
       }
+
+      has_fixpoint = true;
     }
 
-    return kYes;
-  } else if (AP_GetDoorShuffleMode() == kSIMPLE_DOORS &&
-             !door_obj.group_name.empty()) {
-    return AP_HasItem(door_obj.group_ap_item_id) ? kYes : kNo;
-  } else {
-    bool has_item = AP_HasItem(door_obj.ap_item_id);
+    Propagate();
+  }
 
-    if (!has_item) {
-      for (const ProgressiveRequirement& prog_req : door_obj.progressives) {
-        if (AP_HasItem(prog_req.ap_item_id, prog_req.quantity)) {
-          has_item = true;
-          break;
+  // Receives every missing item that directly gates something next to the
+  // reachable area: the items for closed doors on exits out of reachable
+  // rooms, or that are required by panels in reachable rooms, and the colors
+  // of unsolved panels in reachable rooms. Returns false if there were none.
+  bool ReceiveGatingItems() {
+    const LogicOptions& options = program.options();
+    const HotGameData& hot_data = GD_GetHotData();
+    bool received = false;
+
+    auto receive_door_items = [&](int door_id) {
+      if (open_doors.Test(door_id) || item_opened_doors.Test(door_id) ||
+          hot_data.door_skip_item[door_id]) {
+        return;
+      }
+
+      int item = graph.door_items[door_id];
+      int quantity = 1;
+      if (options.door_shuffle_mode == kSIMPLE_DOORS &&
+          hot_data.door_in_group[door_id]) {
+        item = graph.door_group_items[door_id];
+      } else if (item == -1) {
+        for (const ItemRequirement& prog_req :
+             graph.door_progressives[door_id]) {
+          if (item == -1 || prog_req.quantity < quantity) {
+            item = prog_req.item;
+            quantity = prog_req.quantity;
+          }
+        }
+      }
+
+      if (item != -1 && item_counts[item] < quantity) {
+        SetItemCount(item, quantity);
+        received = true;
+      }
+    };
+
+    if (options.door_shuffle_mode != kNO_DOORS) {
+      for (const CompiledExit& room_exit : exit_table.exits) {
+        if (room_exit.door != -1 &&
+            reachable_rooms.Test(room_exit.source_room) &&
+            !reachable_rooms.Test(room_exit.destination_room)) {
+          receive_door_items(room_exit.door);
+        }
+      }
+    }
+
+    for (int panel_id = 0; panel_id < hot_data.panel_rooms.size();
+         panel_id++) {
+      if (solveable_panels.Test(panel_id) ||
+          !reachable_rooms.Test(hot_data.panel_rooms[panel_id])) {
+        continue;
+      }
+
+      if (options.door_shuffle_mode != kNO_DOORS) {
+        for (int door_id : hot_data.panel_required_doors[panel_id]) {
+          receive_door_items(door_id);
+        }
+      }
+
+      if (options.color_shuffle) {
+        for (LingoColor color : hot_data.panel_colors[panel_id]) {
+          int item = graph.color_items[static_cast<int>(color)];
+          if (item != -1 && item_counts[item] == 0) {
+            SetItemCount(item, 1);
+            received = true;
+          }
         }
       }
     }
 
-    return has_item ? kYes : kNo;
+    return received;
   }
-}
 
-Decision IsPanelReachable_Helper(int panel_id,
-                                 const std::set<int>& reachable_rooms,
-                                 const std::set<int>& solveable_panels) {
-  const Panel& panel_obj = GD_GetPanel(panel_id);
+  bool IsLocationReachable(int location_id) const {
+    const HotGameData& hot_data = GD_GetHotData();
+    if (!reachable_rooms.Test(hot_data.location_rooms[location_id])) {
+      return false;
+    }
+
+    for (int panel_id : hot_data.location_panels[location_id]) {
+      if (!solveable_panels.Test(panel_id)) {
+        return false;
+      }
+    }
+
+    return true;
+  }
 
-  if (!reachable_rooms.count(panel_obj.room)) {
-    return kMaybe;
+ private:
+  bool HasItem(int item, int quantity = 1) const {
+    return item != -1 && item_counts[item] >= quantity;
   }
 
-  if (panel_obj.name == "THE MASTER") {
-    int achievements_accessible = 0;
+  template <DoorShuffleMode kDoorShuffleMode, bool kColorShuffle>
+  void SetItemCount_Impl(int item, int count) {
+    if (item_counts[item] == count) {
+      return;
+    }
 
-    for (int achieve_id : GD_GetAchievementPanels()) {
-      if (solveable_panels.count(achieve_id)) {
-        achievements_accessible++;
+    item_counts[item] = count;
+    if (count > 0) {
+      received_items.Set(item);
+    }
 
-        if (achievements_accessible >= AP_GetMasteryRequirement()) {
-          break;
+    if constexpr (kDoorShuffleMode != kNO_DOORS) {
+      for (int door_id : graph.item_dependent_doors[item]) {
+        if (!item_opened_doors.Test(door_id) &&
+            HasDoorItems<kDoorShuffleMode>(door_id)) {
+          item_opened_doors.Set(door_id);
+          door_worklist.push_back(door_id);
         }
       }
     }
 
-    return (achievements_accessible >= AP_GetMasteryRequirement()) ? kYes
-                                                                   : kMaybe;
+    if constexpr (kColorShuffle) {
+      for (int panel_id : graph.item_dependent_panels[item]) {
+        panel_worklist.push_back(panel_id);
+      }
+    }
+  }
+
+  template <DoorShuffleMode kDoorShuffleMode>
+  static SetItemCountFn SelectSetItemCount(bool color_shuffle) {
+    return color_shuffle ? &Solver::SetItemCount_Impl<kDoorShuffleMode, true>
+                         : &Solver::SetItemCount_Impl<kDoorShuffleMode, false>;
   }
 
-  if (panel_obj.name == "ANOTHER TRY" && AP_GetVictoryCondition() == kLEVEL_2) {
-    int counting_panels_accessible = 0;
+  static SetItemCountFn SelectSetItemCount(const LogicOptions& options) {
+    switch (options.door_shuffle_mode) {
+      case kSIMPLE_DOORS:
+        return SelectSetItemCount<kSIMPLE_DOORS>(options.color_shuffle);
+      case kCOMPLEX_DOORS:
+        return SelectSetItemCount<kCOMPLEX_DOORS>(options.color_shuffle);
+      default:
+        return SelectSetItemCount<kNO_DOORS>(options.color_shuffle);
+    }
+  }
 
-    for (int solved_panel_id : solveable_panels) {
-      const Panel& solved_panel = GD_GetPanel(solved_panel_id);
+  template <DoorShuffleMode kDoorShuffleMode>
+  bool HasDoorItems(int door_id) const {
+    if constexpr (kDoorShuffleMode == kSIMPLE_DOORS) {
+      if (GD_GetHotData().door_in_group[door_id]) {
+        return HasItem(graph.door_group_items[door_id]);
+      }
+    }
 
-      if (!solved_panel.non_counting) {
-        counting_panels_accessible++;
+    if (HasItem(graph.door_items[door_id])) {
+      return true;
+    }
+
+    for (const ItemRequirement& prog_req : graph.door_progressives[door_id]) {
+      if (HasItem(prog_req.item, prog_req.quantity)) {
+        return true;
       }
     }
 
-    return (counting_panels_accessible >= AP_GetLevel2Requirement() - 1)
-               ? kYes
-               : kMaybe;
+    return false;
   }
 
-  for (int room_id : panel_obj.required_rooms) {
-    if (!reachable_rooms.count(room_id)) {
-      return kMaybe;
+  void Propagate() {
+    for (;;) {
+      if (!exit_worklist.empty()) {
+        int exit_index = exit_worklist.back();
+        exit_worklist.pop_back();
+
+        const CompiledExit& room_exit = exit_table.exits.at(exit_index);
+        if (!reachable_rooms.Test(room_exit.destination_room) &&
+            reachable_rooms.Test(room_exit.source_room) &&
+            (room_exit.door == -1 || open_doors.Test(room_exit.door))) {
+          ReachRoom(room_exit.destination_room);
+        }
+      } else if (!door_worklist.empty()) {
+        int door_id = door_worklist.back();
+        door_worklist.pop_back();
+
+        if (!open_doors.Test(door_id) && Evaluate(program.door(door_id))) {
+          open_doors.Set(door_id);
+
+          for (int exit_index : exit_table.door_dependent_exits[door_id]) {
+            exit_worklist.push_back(exit_index);
+          }
+
+          for (int panel_id : graph.door_dependent_panels[door_id]) {
+            panel_worklist.push_back(panel_id);
+          }
+        }
+      } else if (!panel_worklist.empty()) {
+        int panel_id = panel_worklist.back();
+        panel_worklist.pop_back();
+
+        if (!solveable_panels.Test(panel_id) &&
+            Evaluate(program.panel(panel_id))) {
+          solveable_panels.Set(panel_id);
+
+          if (graph.achievement_panels.Test(panel_id)) {
+            achievements_solveable++;
+
+            if (achievements_solveable ==
+                program.options().mastery_requirement) {
+              panel_worklist.insert(panel_worklist.end(),
+                                    graph.master_panels.begin(),
+                                    graph.master_panels.end());
+            }
+          }
+
+          if (graph.counting_panels.Test(panel_id)) {
+            counting_panels_solveable++;
+
+            if (counting_panels_solveable ==
+                program.options().level_2_requirement - 1) {
+              panel_worklist.insert(panel_worklist.end(),
+                                    graph.another_try_panels.begin(),
+                                    graph.another_try_panels.end());
+            }
+          }
+
+          for (int door_id : graph.panel_dependent_doors[panel_id]) {
+            door_worklist.push_back(door_id);
+          }
+
+          for (int dependent_id : graph.panel_dependent_panels[panel_id]) {
+            panel_worklist.push_back(dependent_id);
+          }
+        }
+      } else {
+        break;
+      }
     }
   }
 
-  for (int door_id : panel_obj.required_doors) {
-    Decision door_reachable =
-        IsDoorReachable_Helper(door_id, reachable_rooms, solveable_panels);
-    if (door_reachable == kNo) {
-      const Door& door_obj = GD_GetDoor(door_id);
-      return (door_obj.is_event || AP_GetDoorShuffleMode() == kNO_DOORS)
-                 ? kMaybe
-                 : kNo;
-    } else if (door_reachable == kMaybe) {
-      return kMaybe;
+  // Reaches every room in the room's component at once.
+  void ReachRoom(int room_id) {
+    if (reachable_rooms.Test(room_id)) {
+      return;
+    }
+
+    int component = exit_table.room_component[room_id];
+
+    for (int member_id : exit_table.component_rooms[component]) {
+      reachable_rooms.Set(member_id);
+
+      for (int door_id : graph.room_dependent_doors[member_id]) {
+        door_worklist.push_back(door_id);
+      }
+
+      for (int panel_id : graph.room_dependent_panels[member_id]) {
+        panel_worklist.push_back(panel_id);
+      }
     }
-  }
 
-  for (int panel_id : panel_obj.required_panels) {
-    if (!solveable_panels.count(panel_id)) {
-      return kMaybe;
+    for (int exit_index = exit_table.component_exit_offsets[component];
+         exit_index < exit_table.component_exit_offsets[component + 1];
+         exit_index++) {
+      exit_worklist.push_back(exit_index);
     }
   }
 
-  if (AP_IsColorShuffle()) {
-    for (LingoColor color : panel_obj.colors) {
-      if (!AP_HasItem(GD_GetItemIdForColor(color))) {
-        return kNo;
+  bool Evaluate(std::span<const RequirementInstruction> instructions) const {
+    for (const RequirementInstruction& instruction : instructions) {
+      uint64_t value = 0;
+      switch (instruction.op) {
+        case RequirementOp::kRooms:
+          value = reachable_rooms.word(instruction.word);
+          break;
+        case RequirementOp::kDoors:
+          value = open_doors.word(instruction.word);
+          break;
+        case RequirementOp::kPanels:
+          value = solveable_panels.word(instruction.word);
+          break;
+        case RequirementOp::kItemOpenedDoors:
+          value = item_opened_doors.word(instruction.word);
+          break;
+        case RequirementOp::kItems:
+          value = received_items.word(instruction.word);
+          break;
+        case RequirementOp::kAchievements:
+          if (static_cast<uint64_t>(achievements_solveable) <
+              instruction.bits) {
+            return false;
+          }
+          continue;
+        case RequirementOp::kCountingPanels:
+          if (static_cast<uint64_t>(counting_panels_solveable) <
+              instruction.bits) {
+            return false;
+          }
+          continue;
+        case RequirementOp::kNever:
+          return false;
+      }
+
+      if ((value & instruction.bits) != instruction.bits) {
+        return false;
       }
     }
+
+    return true;
   }
+};
 
-  return kYes;
-}
+// An item that the solver can be asked about, under the current slot options.
+// Progressive items can be received up to max_quantity times.
+struct ItemCandidate {
+  int item = -1;
+  int ap_item_id = -1;
+  std::string item_name;
+  int max_quantity = 0;
+};
 
-}  // namespace
+struct TrackerState {
+  TrackerState() {
+    auto initial_snapshot = std::make_shared<ReachabilitySnapshot>();
+    initial_snapshot->reachable_locations.Resize(GD_GetLocationCount());
+    initial_snapshot->checked_locations.Resize(GD_GetLocationCount());
+    initial_snapshot->out_of_logic_locations.Resize(GD_GetLocationCount());
+    initial_snapshot->changed_locations.Resize(GD_GetLocationCount());
+    initial_snapshot->sphere_depths.assign(GD_GetLocationCount(), -1);
+    initial_snapshot->open_doors.Resize(GD_GetDoors().size());
+    PublishSnapshot(std::move(initial_snapshot));
+
+    Reset();
+  }
 
-void RecalculateReachability() {
-  std::set<int> reachable_rooms;
-  std::set<int> solveable_panels;
+#ifdef __cpp_lib_atomic_shared_ptr
+  std::atomic<std::shared_ptr<const ReachabilitySnapshot>> snapshot;
 
-  std::list<int> panel_boundary;
-  std::list<Exit> flood_boundary;
-  flood_boundary.push_back({.destination_room = GD_GetRoomByName("Menu")});
+  std::shared_ptr<const ReachabilitySnapshot> LoadSnapshot() const {
+    return snapshot.load();
+  }
 
-  if (AP_HasEarlyColorHallways()) {
-    flood_boundary.push_back(
-        {.destination_room = GD_GetRoomByName("Outside The Undeterred")});
+  void PublishSnapshot(std::shared_ptr<const ReachabilitySnapshot> arg) {
+    snapshot.store(std::move(arg));
   }
+#else
+  std::shared_ptr<const ReachabilitySnapshot> snapshot;
 
-  bool reachable_changed = true;
-  while (reachable_changed) {
-    reachable_changed = false;
+  std::shared_ptr<const ReachabilitySnapshot> LoadSnapshot() const {
+    return std::atomic_load(&snapshot);
+  }
 
-    std::list<int> new_panel_boundary;
-    for (int panel_id : panel_boundary) {
-      if (solveable_panels.count(panel_id)) {
-        continue;
+  void PublishSnapshot(std::shared_ptr<const ReachabilitySnapshot> arg) {
+    std::atomic_store(&snapshot, std::move(arg));
+  }
+#endif
+
+  RequirementGraph graph;
+  ExitTable exit_table;
+  RequirementProgram program;
+  Solver solver{graph, exit_table, program};
+
+  // Runs alongside the main solver, ignoring soft requirements.
+  RequirementProgram relaxed_program;
+  Solver relaxed_solver{graph, exit_table, relaxed_program};
+  std::vector<int> start_rooms;
+  std::shared_ptr<const DominatorTree> dominators;
+  std::shared_ptr<const RouteTree> routes;
+
+  // Memory that is reused from one recalculation to the next, so that a
+  // recalculation allocates nothing once the slot has warmed up.
+  Solver layered_solver{graph, exit_table, program};
+  DenseBitset scratch_changes;
+  std::vector<int> unreached_locations;
+  ObjectPool<ReachabilitySnapshot> snapshot_pool;
+  ObjectPool<RouteTree> route_pool;
+
+  // Locations found to be reachable since the last reset. Items are never
+  // taken away, so only the rest have to be checked against the solver.
+  DenseBitset known_reachable;
+
+  // Set by Reset, so that the next snapshot is treated as entirely new.
+  bool reset_since_snapshot = true;
+
+  // The sphere depths only depend on the inventory, so they are kept until it
+  // changes. sphere_depth_items is the inventory they were computed for.
+  bool has_sphere_depths = false;
+  std::vector<int> sphere_depths;
+  std::vector<int> sphere_depth_items;
+
+  std::vector<ItemCandidate> item_candidates;
+
+  // The snapshot version and inventory that the last completed item analysis
+  // was based on. Receiving an item doesn't always lead to a new snapshot, so
+  // both are needed. Reset clears has_analysis, so that it is redone anyway.
+  bool has_analysis = false;
+  uint64_t analyzed_version = 0;
+  std::vector<int> analyzed_items;
+
+  // Solvers for the hypothetical inventories. Each worker holds one while it
+  // evaluates an item, so there are never more of them than workers.
+  std::mutex hypothetical_mutex;
+  std::vector<std::unique_ptr<Solver>> hypothetical_solvers;
+
+  std::mutex item_unlocks_mutex;
+  std::shared_ptr<const std::vector<ItemUnlock>> item_unlocks =
+      std::make_shared<std::vector<ItemUnlock>>();
+
+  void Reset() {
+    if (AP_IsPaintingShuffle()) {
+      std::vector<std::vector<Exit>> painting_exits = AP_GetPaintingExits();
+      exit_table = ExitTable(&painting_exits);
+    } else {
+      exit_table = ExitTable();
+    }
+
+    LogicOptions options = GetLogicOptions();
+    program = RequirementProgram(graph, options);
+    solver.Reset();
+    relaxed_program =
+        RequirementProgram(graph, options, /*ignore_soft_requirements=*/true);
+    relaxed_solver.Reset();
+
+    start_rooms = {GD_GetRoomByName("Menu")};
+    if (program.options().early_color_hallways) {
+      start_rooms.push_back(GD_GetRoomByName("Outside The Undeterred"));
+    }
+    dominators = std::make_shared<DominatorTree>(exit_table, start_rooms);
+    routes = nullptr;
+
+    known_reachable.Resize(GD_GetLocationCount());
+    reset_since_snapshot = true;
+    has_sphere_depths = false;
+    has_analysis = false;
+
+    CollectItemCandidates();
+    PublishItemUnlocks(std::make_shared<std::vector<ItemUnlock>>());
+  }
+
+  std::shared_ptr<const std::vector<ItemUnlock>> LoadItemUnlocks() {
+    std::lock_guard unlocks_guard(item_unlocks_mutex);
+    return item_unlocks;
+  }
+
+  void PublishItemUnlocks(std::shared_ptr<const std::vector<ItemUnlock>> arg) {
+    std::lock_guard unlocks_guard(item_unlocks_mutex);
+    item_unlocks = std::move(arg);
+  }
+
+  // Fills in the sphere depths and the locations reachable by the relaxed
+  // solver, and brings the known reachable locations up to date. The relaxed
+  // solver doesn't depend on the main one, so the two run side by side.
+  void UpdateLocations(ReachabilitySnapshot& snapshot) {
+    GetAnalysisPool().ParallelFor(2, [this, &snapshot](int pass) {
+      if (pass == 0) {
+        UpdateInLogic(snapshot.sphere_depths);
+      } else {
+        UpdateRelaxed(snapshot.out_of_logic_locations);
       }
+    });
+  }
 
-      Decision panel_reachable =
-          IsPanelReachable_Helper(panel_id, reachable_rooms, solveable_panels);
-      if (panel_reachable == kYes) {
-        solveable_panels.insert(panel_id);
-        reachable_changed = true;
-      } else if (panel_reachable == kMaybe) {
-        new_panel_boundary.push_back(panel_id);
+  // Brings the solver and the locations known to be reachable up to date,
+  // then the sphere depths if the inventory has changed. Both are read from
+  // the same fixpoint, which the open doors in the snapshot need anyway.
+  void UpdateInLogic(std::vector<int>& snapshot_depths) {
+    solver.Recalculate();
+
+    for (int location_id = 0; location_id < GD_GetLocationCount();
+         location_id++) {
+      if (!known_reachable.Test(location_id) &&
+          solver.IsLocationReachable(location_id)) {
+        known_reachable.Set(location_id);
       }
     }
 
-    std::list<Exit> new_boundary;
-    for (const Exit& room_exit : flood_boundary) {
-      if (reachable_rooms.count(room_exit.destination_room)) {
-        continue;
+    if (!has_sphere_depths || sphere_depth_items != solver.item_counts) {
+      ComputeSphereDepths();
+      sphere_depth_items = solver.item_counts;
+      has_sphere_depths = true;
+    }
+
+    snapshot_depths = sphere_depths;
+  }
+
+  // Finds every location that the relaxed solver can reach, including the
+  // ones that are in logic.
+  void UpdateRelaxed(DenseBitset& relaxed_locations) {
+    relaxed_solver.Recalculate();
+
+    relaxed_locations.Resize(GD_GetLocationCount());
+    for (int location_id = 0; location_id < GD_GetLocationCount();
+         location_id++) {
+      if (relaxed_solver.IsLocationReachable(location_id)) {
+        relaxed_locations.Set(location_id);
       }
+    }
+  }
 
-      bool valid_transition = false;
-      if (room_exit.door.has_value()) {
-        Decision door_reachable = IsDoorReachable_Helper(
-            *room_exit.door, reachable_rooms, solveable_panels);
-        if (door_reachable == kYes) {
-          valid_transition = true;
-        } else if (door_reachable == kMaybe) {
-          new_boundary.push_back(room_exit);
-        }
+  // Runs the solver forward in layers from the current fixpoint. Each layer
+  // receives all of the items that gate the area reached by the one before,
+  // and the locations it reaches get its index as their sphere depth. The
+  // solver and the known reachable locations have to be up to date.
+  void ComputeSphereDepths() {
+    sphere_depths.assign(GD_GetLocationCount(), -1);
+
+    // The known reachable locations are exactly the ones at depth 0, so only
+    // the rest have to be checked in each layer.
+    unreached_locations.clear();
+    for (int location_id = 0; location_id < GD_GetLocationCount();
+         location_id++) {
+      if (known_reachable.Test(location_id)) {
+        sphere_depths[location_id] = 0;
       } else {
-        valid_transition = true;
+        unreached_locations.push_back(location_id);
       }
+    }
 
-      if (valid_transition) {
-        reachable_rooms.insert(room_exit.destination_room);
-        reachable_changed = true;
+    Solver& layered = layered_solver;
+    layered.CopyStateFrom(solver);
 
-        const Room& room_obj = GD_GetRoom(room_exit.destination_room);
-        for (const Exit& out_edge : room_obj.exits) {
-          if (!out_edge.painting || !AP_IsPaintingShuffle()) {
-            new_boundary.push_back(out_edge);
-          }
+    for (int depth = 1; !unreached_locations.empty(); depth++) {
+      if (!layered.ReceiveGatingItems()) {
+        break;
+      }
+
+      layered.Recalculate();
+
+      std::erase_if(unreached_locations, [this, &layered, depth](int id) {
+        if (!layered.IsLocationReachable(id)) {
+          return false;
+        }
+
+        sphere_depths[id] = depth;
+        return true;
+      });
+    }
+  }
+
+  bool AnalyzeItemUnlocks(const std::function<bool()>& should_stop) {
+    std::shared_ptr<const ReachabilitySnapshot> current = LoadSnapshot();
+    if (has_analysis && current->version == analyzed_version &&
+        solver.item_counts == analyzed_items) {
+      return false;
+    }
+
+    // The hypothetical inventories start from the solver's fixpoint, which is
+    // only brought up to date on demand.
+    solver.Recalculate();
+
+    // Only the locations that the player could still go after matter.
+    const HotGameData& hot_data = GD_GetHotData();
+    std::vector<int> unreachable_locations;
+
+    for (int location_id = 0; location_id < GD_GetLocationCount();
+         location_id++) {
+      if (!current->reachable_locations.Test(location_id) &&
+          AP_IsLocationVisible(
+              hot_data.location_classifications[location_id]) &&
+          !AP_HasCheckedGameLocation(hot_data.location_ap_ids[location_id])) {
+        unreachable_locations.push_back(location_id);
+      }
+    }
+
+    std::vector<const ItemCandidate*> missing_items;
+    if (!unreachable_locations.empty()) {
+      for (const ItemCandidate& candidate : item_candidates) {
+        if (solver.item_counts[candidate.item] < candidate.max_quantity) {
+          missing_items.push_back(&candidate);
         }
+      }
+    }
 
-        if (AP_IsPaintingShuffle()) {
-          for (const PaintingExit& out_edge : room_obj.paintings) {
-            if (AP_GetPaintingMapping().count(out_edge.id)) {
-              Exit painting_exit;
-              painting_exit.destination_room = GD_GetRoomForPainting(
-                  AP_GetPaintingMapping().at(out_edge.id));
-              painting_exit.door = out_edge.door;
+    std::vector<int> unlocked(missing_items.size(), 0);
+    std::atomic<bool> stopped = false;
 
-              new_boundary.push_back(painting_exit);
+    GetAnalysisPool().ParallelFor(
+        missing_items.size(),
+        [this, &missing_items, &unreachable_locations, &unlocked, &stopped,
+         &should_stop](int i) {
+          if (stopped || should_stop()) {
+            stopped = true;
+            return;
+          }
+
+          const ItemCandidate& candidate = *missing_items.at(i);
+
+          std::unique_ptr<Solver> hypothetical = AcquireHypotheticalSolver();
+          hypothetical->CopyStateFrom(solver);
+          hypothetical->SetItemCount(candidate.item,
+                                     solver.item_counts[candidate.item] + 1);
+          hypothetical->Recalculate();
+
+          for (int location_id : unreachable_locations) {
+            if (hypothetical->IsLocationReachable(location_id)) {
+              unlocked[i]++;
             }
           }
-        }
 
-        for (int panel_id : room_obj.panels) {
-          new_panel_boundary.push_back(panel_id);
-        }
+          ReleaseHypotheticalSolver(std::move(hypothetical));
+        });
+
+    if (stopped) {
+      return false;
+    }
+
+    auto result = std::make_shared<std::vector<ItemUnlock>>();
+    for (int i = 0; i < missing_items.size(); i++) {
+      if (unlocked.at(i) > 0) {
+        result->push_back({.ap_item_id = missing_items.at(i)->ap_item_id,
+                           .item_name = missing_items.at(i)->item_name,
+                           .locations = unlocked.at(i)});
       }
     }
 
-    flood_boundary = new_boundary;
-    panel_boundary = new_panel_boundary;
+    std::sort(result->begin(), result->end(),
+              [](const ItemUnlock& lhs, const ItemUnlock& rhs) {
+                return std::tie(rhs.locations, lhs.item_name) <
+                       std::tie(lhs.locations, rhs.item_name);
+              });
+
+    PublishItemUnlocks(std::move(result));
+    has_analysis = true;
+    analyzed_version = current->version;
+    analyzed_items = solver.item_counts;
+
+    return true;
+  }
+
+ private:
+  std::unique_ptr<Solver> AcquireHypotheticalSolver() {
+    std::lock_guard hypothetical_guard(hypothetical_mutex);
+    if (hypothetical_solvers.empty()) {
+      return std::make_unique<Solver>(graph, exit_table, program);
+    }
+
+    std::unique_ptr<Solver> hypothetical =
+        std::move(hypothetical_solvers.back());
+    hypothetical_solvers.pop_back();
+    return hypothetical;
+  }
+
+  void ReleaseHypotheticalSolver(std::unique_ptr<Solver> hypothetical) {
+    std::lock_guard hypothetical_guard(hypothetical_mutex);
+    hypothetical_solvers.push_back(std::move(hypothetical));
   }
 
-  std::map<int, bool> new_reachability;
-  for (const MapArea& map_area : GD_GetMapAreas()) {
-    for (size_t section_id = 0; section_id < map_area.locations.size();
-         section_id++) {
-      const Location& location_section = map_area.locations.at(section_id);
-      bool reachable = reachable_rooms.count(location_section.room);
-      if (reachable) {
-        for (int panel_id : location_section.panels) {
-          reachable &= (solveable_panels.count(panel_id) == 1);
+  void CollectItemCandidates() {
+    std::map<int, ItemCandidate> candidates;
+    auto add_candidate = [this, &candidates](int ap_item_id,
+                                             std::string_view item_name,
+                                             int quantity) {
+      if (ap_item_id == -1) {
+        return;
+      }
+
+      ItemCandidate& candidate = candidates[ap_item_id];
+      candidate.item = graph.FindItem(ap_item_id);
+      candidate.ap_item_id = ap_item_id;
+      candidate.item_name = item_name;
+      candidate.max_quantity = std::max(candidate.max_quantity, quantity);
+    };
+
+    if (program.options().door_shuffle_mode != kNO_DOORS) {
+      for (int door_id : graph.item_doors) {
+        const Door& door_obj = GD_GetDoor(door_id);
+
+        if (program.options().door_shuffle_mode == kSIMPLE_DOORS &&
+            !door_obj.group_name.empty()) {
+          add_candidate(door_obj.group_ap_item_id, door_obj.group_name, 1);
+        } else {
+          add_candidate(door_obj.ap_item_id, door_obj.item_name, 1);
+
+          for (const ProgressiveRequirement& prog_req : door_obj.progressives) {
+            add_candidate(prog_req.ap_item_id, prog_req.item_name,
+                          prog_req.quantity);
+          }
         }
       }
+    }
+
+    if (program.options().color_shuffle) {
+      for (LingoColor color :
+           {LingoColor::kBlack, LingoColor::kRed, LingoColor::kBlue,
+            LingoColor::kYellow, LingoColor::kGreen, LingoColor::kOrange,
+            LingoColor::kPurple, LingoColor::kBrown, LingoColor::kGray}) {
+        add_candidate(GD_FindItemIdForColor(color), GetColorName(color), 1);
+      }
+    }
 
-      new_reachability[location_section.ap_location_id] = reachable;
+    item_candidates.clear();
+    for (auto& [ap_item_id, candidate] : candidates) {
+      item_candidates.push_back(std::move(candidate));
     }
   }
 
-  {
-    std::lock_guard reachability_guard(GetState().reachability_mutex);
-    std::swap(GetState().reachability, new_reachability);
+  static ThreadPool& GetAnalysisPool() {
+    static ThreadPool* pool =
+        new ThreadPool(std::max(1u, std::thread::hardware_concurrency()));
+    return *pool;
   }
+};
+
+TrackerState& GetState() {
+  static TrackerState* instance = new TrackerState();
+  return *instance;
 }
 
-bool IsLocationReachable(int location_id) {
-  std::lock_guard reachability_guard(GetState().reachability_mutex);
+}  // namespace
+
+void ResetReachabilityRequirements() { GetState().Reset(); }
+
+bool RecalculateReachability() {
+  TrackerState& state = GetState();
+  AP_VisitInventory([&state](int64_t ap_item_id, int count) {
+    state.solver.ReceiveItem(ap_item_id, count);
+    state.relaxed_solver.ReceiveItem(ap_item_id, count);
+  });
+
+  std::shared_ptr<const ReachabilitySnapshot> old_snapshot =
+      state.LoadSnapshot();
+
+  std::shared_ptr<ReachabilitySnapshot> new_snapshot =
+      state.snapshot_pool.Acquire();
+  new_snapshot->version = old_snapshot->version + 1;
+
+  state.UpdateLocations(*new_snapshot);
+
+  new_snapshot->reachable_locations = state.known_reachable;
+  new_snapshot->out_of_logic_locations.RemoveAll(
+      new_snapshot->reachable_locations);
+  const HotGameData& hot_data = GD_GetHotData();
+  new_snapshot->checked_locations.Resize(GD_GetLocationCount());
+  for (int location_id = 0; location_id < GD_GetLocationCount();
+       location_id++) {
+    if (AP_HasCheckedGameLocation(hot_data.location_ap_ids[location_id])) {
+      new_snapshot->checked_locations.Set(location_id);
+    }
+  }
+
+  new_snapshot->open_doors = state.solver.open_doors;
+  new_snapshot->dominators = state.dominators;
 
-  if (GetState().reachability.count(location_id)) {
-    return GetState().reachability.at(location_id);
+  DenseBitset& changed = new_snapshot->changed_locations;
+  if (state.reset_since_snapshot) {
+    changed.Resize(GD_GetLocationCount());
+    changed.SetAll();
+    state.reset_since_snapshot = false;
   } else {
-    return false;
+    changed = new_snapshot->reachable_locations;
+    changed ^= old_snapshot->reachable_locations;
+
+    state.scratch_changes = new_snapshot->checked_locations;
+    state.scratch_changes ^= old_snapshot->checked_locations;
+    changed |= state.scratch_changes;
+
+    state.scratch_changes = new_snapshot->out_of_logic_locations;
+    state.scratch_changes ^= old_snapshot->out_of_logic_locations;
+    changed |= state.scratch_changes;
+
+    // Opening a door can change which doors stand in the way of the locations
+    // that are still out of reach, even if none of them come into reach.
+    bool doors_changed = new_snapshot->open_doors != old_snapshot->open_doors;
+
+    for (int location_id = 0; location_id < GD_GetLocationCount();
+         location_id++) {
+      if (new_snapshot->sphere_depths[location_id] !=
+              old_snapshot->sphere_depths[location_id] ||
+          (doors_changed &&
+           !new_snapshot->reachable_locations.Test(location_id))) {
+        changed.Set(location_id);
+      }
+    }
+
+    if (!changed.Any() && !doors_changed) {
+      return false;
+    }
+  }
+
+  if (!state.routes || new_snapshot->open_doors != old_snapshot->open_doors) {
+    std::shared_ptr<RouteTree> new_routes = state.route_pool.Acquire();
+    new_routes->Rebuild(state.exit_table, state.start_rooms,
+                        new_snapshot->open_doors);
+    state.routes = std::move(new_routes);
   }
+  new_snapshot->routes = state.routes;
+
+  state.PublishSnapshot(std::move(new_snapshot));
+
+  return true;
+}
+
+std::shared_ptr<const ReachabilitySnapshot> GetReachabilitySnapshot() {
+  return GetState().LoadSnapshot();
+}
+
+bool AnalyzeItemUnlocks(const std::function<bool()>& should_stop) {
+  return GetState().AnalyzeItemUnlocks(should_stop);
+}
+
+std::shared_ptr<const std::vector<ItemUnlock>> GetItemUnlocks() {
+  return GetState().LoadItemUnlocks();
 }
@@ -1,8 +1,86 @@
 #ifndef TRACKER_STATE_H_8639BC90
 #define TRACKER_STATE_H_8639BC90
 
-void RecalculateReachability();
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
 
-bool IsLocationReachable(int location_id);
+#include "dense_bitset.h"
+#include "dominator_tree.h"
+#include "route_tree.h"
+
+// The result of a reachability recalculation. Snapshots are never modified
+// once they have been published, so they can be read without locking.
+struct ReachabilitySnapshot {
+  uint64_t version = 0;
+
+  // Indexed by Location::id.
+  DenseBitset reachable_locations;
+  DenseBitset checked_locations;
+
+  // Locations that are out of logic, but can be reached by ignoring the
+  // requirements that don't physically stand in the way. See
+  // RequirementProgram.
+  DenseBitset out_of_logic_locations;
+
+  // The locations whose reachability, out-of-logic status, checked status,
+  // sphere depth or closed unavoidable doors differ from the snapshot with the
+  // previous version. Every location is marked after the requirements have
+  // been reset.
+  DenseBitset changed_locations;
+
+  // How many rounds of receiving the items that gate the reachable area it
+  // takes for each location to come into logic: 0 if it is reachable now, -1
+  // if it never does. Indexed by Location::id.
+  std::vector<int> sphere_depths;
+
+  // The doors that the solver considers open, indexed by door id, and the
+  // dominator tree of the slot's room graph. Together they tell which doors
+  // still stand between the start and an unreachable location. The tree is
+  // null until a slot's logic has been set up.
+  DenseBitset open_doors;
+  std::shared_ptr<const DominatorTree> dominators;
+
+  // The shortest routes to the reachable rooms. Shared with the previous
+  // snapshot when no doors have opened since. Null until a slot's logic has
+  // been set up.
+  std::shared_ptr<const RouteTree> routes;
+};
+
+// Discards the logic state carried between recalculations. This needs to be
+// called whenever the slot options change, e.g. when connecting to a slot.
+void ResetReachabilityRequirements();
+
+// Brings reachability up to date with the current inventory and checked
+// locations. This resumes from the previous result unless the requirements
+// were reset in the meantime. Returns false without publishing a new snapshot
+// if nothing changed, in which case the display doesn't need to be updated.
+bool RecalculateReachability();
+
+std::shared_ptr<const ReachabilitySnapshot> GetReachabilitySnapshot();
+
+// How many of the locations that are currently out of logic would be put into
+// logic by receiving one more of an item.
+struct ItemUnlock {
+  int ap_item_id;
+  std::string item_name;
+  int locations;
+};
+
+// Evaluates every item that has not been received yet against the latest
+// reachability, spread across a thread pool. Only visible locations that have
+// not been checked are counted. If should_stop returns true before the
+// analysis finishes, it gives up and returns false without publishing
+// anything, e.g. because the inventory has changed again in the meantime.
+// It also returns false straight away if the latest reachability and inventory
+// have already been analyzed, so it only does work after a change, a reset, or
+// an analysis that was given up on.
+bool AnalyzeItemUnlocks(const std::function<bool()>& should_stop);
+
+// The result of the last completed analysis: the items that would unlock at
+// least one location, most locations first.
+std::shared_ptr<const std::vector<ItemUnlock>> GetItemUnlocks();
 
 #endif /* end of include guard: TRACKER_STATE_H_8639BC90 */
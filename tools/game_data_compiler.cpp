@@ -0,0 +1,53 @@
+// Parses the game data in assets/, relative to the working directory, and
+// writes a source file that compiles the resulting image into the tracker.
+//
+// Usage: game_data_compiler <output.cpp>
+
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "game_data.h"
+
+int main(int argc, char** argv) {
+  if (argc != 2) {
+    std::cerr << "Usage: " << argv[0] << " <output.cpp>" << std::endl;
+    return 1;
+  }
+
+  std::string image;
+  try {
+    image = GD_SerializeGameData();
+  } catch (const std::exception& ex) {
+    std::cerr << "Could not load the game data: " << ex.what() << std::endl;
+    return 1;
+  }
+
+  std::ofstream output(argv[1]);
+  output << "// Generated by game_data_compiler. Do not edit.\n\n"
+         << "#include \"embedded_game_data.h\"\n\n"
+         << "namespace {\n\n"
+         << "constexpr unsigned char kGameData[] = {";
+
+  for (size_t i = 0; i < image.size(); i++) {
+    output << (i % 12 == 0 ? "\n    " : " ") << "0x" << std::hex
+           << std::setw(2) << std::setfill('0')
+           << static_cast<int>(static_cast<unsigned char>(image[i])) << ",";
+  }
+
+  output << std::dec << "\n};\n\n"
+         << "}  // namespace\n\n"
+         << "std::string_view GetEmbeddedGameData() {\n"
+         << "  return {reinterpret_cast<const char*>(kGameData), "
+         << image.size() << "};\n"
+         << "}\n";
+
+  if (!output) {
+    std::cerr << "Could not write " << argv[1] << std::endl;
+    return 1;
+  }
+
+  return 0;
+}